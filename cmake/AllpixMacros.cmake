@@ -47,8 +47,18 @@ MACRO(_allpix_module_define_common name)
 Create the header or provide the alternative class name as first argument")
     ENDIF()
 
-    # Define the library
-    ADD_LIBRARY(${${name}} SHARED "")
+    # Define the library, linked statically into the executable or loaded at runtime
+    IF(BUILD_STATIC_EXECUTABLE AND NOT ALLPIX_MODULE_EXTERNAL)
+        ADD_LIBRARY(${${name}} STATIC "")
+        SET(_allpix_module_impl "static_module_impl.cpp")
+
+        # Name the factory function uniquely and register the module in the executable
+        TARGET_COMPILE_DEFINITIONS(${${name}} PRIVATE ALLPIX_MODULE_FACTORY=allpix_module_factory_${_allpix_module_dir})
+        SET(ALLPIX_STATIC_MODULES ${ALLPIX_STATIC_MODULES} ${_allpix_module_dir} CACHE INTERNAL "Static modules")
+    ELSE()
+        ADD_LIBRARY(${${name}} SHARED "")
+        SET(_allpix_module_impl "dynamic_module_impl.cpp")
+    ENDIF()
 
     # Add the current directory as include directory
     TARGET_INCLUDE_DIRECTORIES(${${name}} PRIVATE ${CMAKE_CURRENT_SOURCE_DIR})
@@ -62,8 +72,8 @@ Create the header or provide the alternative class name as first argument")
         TARGET_SOURCES(${${name}} PRIVATE "${ALLPIX_INCLUDE_DIR}/core/module/dynamic_module_impl.cpp")
         SET_PROPERTY(SOURCE "${ALLPIX_INCLUDE_DIR}/dynamic_module_impl.cpp" APPEND PROPERTY OBJECT_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/${_allpix_module_class}.hpp")
     ELSE()
-        TARGET_SOURCES(${${name}} PRIVATE "${PROJECT_SOURCE_DIR}/src/core/module/dynamic_module_impl.cpp")
-        SET_PROPERTY(SOURCE "${PROJECT_SOURCE_DIR}/src/core/module/dynamic_module_impl.cpp" APPEND PROPERTY OBJECT_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/${_allpix_module_class}.hpp")
+        TARGET_SOURCES(${${name}} PRIVATE "${PROJECT_SOURCE_DIR}/src/core/module/${_allpix_module_impl}")
+        SET_PROPERTY(SOURCE "${PROJECT_SOURCE_DIR}/src/core/module/${_allpix_module_impl}" APPEND PROPERTY OBJECT_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/${_allpix_module_class}.hpp")
         SET_PROPERTY(SOURCE "${PROJECT_SOURCE_DIR}/src/core/module/Module.cpp" APPEND PROPERTY OBJECT_DEPENDS "${CMAKE_CURRENT_SOURCE_DIR}/${_allpix_module_class}.hpp")
 
         # Add to the interface library for devices:
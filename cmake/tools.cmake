@@ -72,9 +72,14 @@ FUNCTION(GET_TEST_REGEX INP OUTPUT_PASS OUTPUT_FAIL)
         FILE(STRINGS ${INP} OUTPUT_FAIL_ REGEX "#FAIL ")
     ENDIF()
 
+    # Expressions which should be used as regular expression without escaping:
+    FILE(STRINGS ${INP} OUTPUT_PASS_REGEX_ REGEX "#PASSREGEX ")
+
     # Check for number of arguments - should only be one:
     LIST(LENGTH OUTPUT_PASS_ LISTCOUNT_PASS)
+    LIST(LENGTH OUTPUT_PASS_REGEX_ LISTCOUNT_PASS_REGEX)
     LIST(LENGTH OUTPUT_FAIL_ LISTCOUNT_FAIL)
+    MATH(EXPR LISTCOUNT_PASS "${LISTCOUNT_PASS} + ${LISTCOUNT_PASS_REGEX}")
     IF(LISTCOUNT_PASS GREATER 1)
         MESSAGE(FATAL_ERROR "More than one PASS expressions defined in test ${INP}")
     ENDIF()
@@ -85,6 +90,9 @@ FUNCTION(GET_TEST_REGEX INP OUTPUT_PASS OUTPUT_FAIL)
     # Escape possible regex patterns in the expected output:
     ESCAPE_REGEX("${OUTPUT_PASS_}" OUTPUT_PASS_)
     ESCAPE_REGEX("${OUTPUT_FAIL_}" OUTPUT_FAIL_)
+    IF(OUTPUT_PASS_REGEX_)
+        STRING(REPLACE "#PASSREGEX " "" OUTPUT_PASS_ "${OUTPUT_PASS_REGEX_}")
+    ENDIF()
 
     SET(${OUTPUT_PASS} "${OUTPUT_PASS_}" PARENT_SCOPE)
     SET(${OUTPUT_FAIL} "${OUTPUT_FAIL_}" PARENT_SCOPE)
@@ -114,9 +122,25 @@ FUNCTION(ADD_ALLPIX_TEST TEST)
         SET(CLIOPTIONS "${CLIOPTIONS} -g ${OPT}")
     ENDFOREACH()
 
+    # Allow the test to split the simulation into several worker processes:
+    FILE(STRINGS ${TEST} JOBS REGEX "#JOBS ")
+    IF(JOBS)
+        STRING(REPLACE "#JOBS " "" JOBS "${JOBS}")
+        SET(CLIOPTIONS "${CLIOPTIONS} -j ${JOBS}")
+    ENDIF()
+
+    SET(TEST_COMMAND "${CMAKE_INSTALL_PREFIX}/bin/allpix -c ${CMAKE_CURRENT_SOURCE_DIR}/${TEST} ${CLIOPTIONS}")
+
+    # Allow the test to read the output stream of the simulation with a consumer connected to the given socket:
+    FILE(STRINGS ${TEST} CONSUMER REGEX "#CONSUMER ")
+    IF(CONSUMER)
+        STRING(REPLACE "#CONSUMER " "" CONSUMER "${CONSUMER}")
+        SET(TEST_COMMAND "${CMAKE_CURRENT_SOURCE_DIR}/stream_consumer.py ${CONSUMER} ${TEST_COMMAND}")
+    ENDIF()
+
     ADD_TEST(NAME ${TEST}
         WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
-        COMMAND ${CMAKE_CURRENT_SOURCE_DIR}/run_directory.sh "output/${TEST}" "${CMAKE_INSTALL_PREFIX}/bin/allpix -c ${CMAKE_CURRENT_SOURCE_DIR}/${TEST} ${CLIOPTIONS}"
+        COMMAND ${CMAKE_CURRENT_SOURCE_DIR}/run_directory.sh "output/${TEST}" "${TEST_COMMAND}"
     )
 
     # Parse configuration file for pass/fail conditions:
@@ -128,6 +152,14 @@ FUNCTION(ADD_ALLPIX_TEST TEST)
         SET_TESTS_PROPERTIES(${TEST} PROPERTIES FAIL_REGULAR_EXPRESSION "${EXPRESSIONS_FAIL}")
     ENDIF()
 
+    # Skip the test if the output indicates that a required feature is not available on this host:
+    FILE(STRINGS ${TEST} EXPRESSION_SKIP REGEX "#SKIP ")
+    IF(EXPRESSION_SKIP AND NOT CMAKE_VERSION VERSION_LESS 3.16)
+        STRING(REPLACE "#SKIP " "" EXPRESSION_SKIP "${EXPRESSION_SKIP}")
+        ESCAPE_REGEX("${EXPRESSION_SKIP}" EXPRESSION_SKIP)
+        SET_TESTS_PROPERTIES(${TEST} PROPERTIES SKIP_REGULAR_EXPRESSION "${EXPRESSION_SKIP}")
+    ENDIF()
+
     # Some tests might depend on others:
     FILE(STRINGS ${TEST} DEPENDENCY REGEX "#DEPENDS ")
     IF(DEPENDENCY)
@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @brief Micro-benchmarks of the core framework components: configuration, units and message dispatching
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "core/config/Configuration.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Module.hpp"
+#include "core/utils/unit.h"
+#include "objects/PixelHit.hpp"
+
+using namespace allpix;
+
+namespace {
+    /**
+     * @brief Module dispatching pixel hits, only used as source of the messages
+     */
+    class SenderModule : public Module {
+    public:
+        explicit SenderModule(Configuration& config) : Module(config) {}
+    };
+
+    /**
+     * @brief Module receiving all pixel hits through a listener method
+     */
+    class ReceiverModule : public Module {
+    public:
+        ReceiverModule(Configuration& config, Messenger* messenger) : Module(config) {
+            messenger->registerListener(this, &ReceiverModule::receive);
+        }
+
+        void receive(std::shared_ptr<PixelHitMessage> message) { benchmark::DoNotOptimize(message->getData().size()); }
+    };
+
+    // Configuration with the input and output names set by the module manager for every module instantiation
+    Configuration create_module_configuration(const std::string& name) {
+        Configuration config(name);
+        config.set<std::string>("input", "");
+        config.set<std::string>("output", "");
+        return config;
+    }
+} // namespace
+
+/**
+ * Parsing of a single value with units, as done for most module parameters
+ */
+static void BM_ConfigurationGetDouble(benchmark::State& state) {
+    Configuration config("Benchmark");
+    config.setText("spatial_precision", "0.25nm");
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config.get<double>("spatial_precision"));
+    }
+}
+BENCHMARK(BM_ConfigurationGetDouble);
+
+static void BM_ConfigurationGetArray(benchmark::State& state) {
+    Configuration config("Benchmark");
+    config.setText("position", "10um -20um 1.5mm");
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config.getArray<double>("position"));
+    }
+}
+BENCHMARK(BM_ConfigurationGetArray);
+
+static void BM_ConfigurationGetString(benchmark::State& state) {
+    Configuration config("Benchmark");
+    config.set<std::string>("output", "pixel_hits");
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(config.get<std::string>("output"));
+    }
+}
+BENCHMARK(BM_ConfigurationGetString);
+
+static void BM_UnitsGetSimple(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(Units::get(1.53, "um"));
+    }
+}
+BENCHMARK(BM_UnitsGetSimple);
+
+/**
+ * Compound units are parsed into their components at every call
+ */
+static void BM_UnitsGetCompound(benchmark::State& state) {
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(Units::get(1.53e9, "cm*cm/V/s"));
+    }
+}
+BENCHMARK(BM_UnitsGetCompound);
+
+/**
+ * Creation and dispatching of a message through the routing table to a variable number of receivers, followed by the
+ * clean-up done by the module manager at the end of every event
+ */
+static void BM_MessengerDispatch(benchmark::State& state) {
+    // NOTE The messenger has to outlive the modules, which remove their delegates when destructed
+    Messenger messenger;
+
+    auto sender_config = create_module_configuration("Sender");
+    SenderModule sender(sender_config);
+
+    auto num_receivers = static_cast<size_t>(state.range(0));
+    std::vector<Configuration> receiver_configs;
+    receiver_configs.reserve(num_receivers);
+    std::vector<std::unique_ptr<ReceiverModule>> receivers;
+    std::vector<Module*> modules{&sender};
+    for(size_t i = 0; i < num_receivers; ++i) {
+        receiver_configs.push_back(create_module_configuration("Receiver" + std::to_string(i)));
+        receivers.push_back(std::make_unique<ReceiverModule>(receiver_configs.back(), &messenger));
+        modules.push_back(receivers.back().get());
+    }
+    messenger.buildRoutingTable(modules);
+
+    for(auto _ : state) {
+        auto message = messenger.createMessage<PixelHitMessage>(std::vector<PixelHit>());
+        messenger.dispatchMessage(&sender, message);
+        message.reset();
+
+        messenger.clearMessages();
+        messenger.resetEventArena();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MessengerDispatch)->Arg(1)->Arg(4)->Arg(16);
@@ -0,0 +1,242 @@
+/**
+ * @file
+ * @brief Micro-benchmarks of the field lookups and the charge carrier transport
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Math/Point3D.h>
+#include <Math/Rotation3D.h>
+#include <Math/Vector3D.h>
+#include <benchmark/benchmark.h>
+
+#include "core/config/ConfigReader.hpp"
+#include "core/geometry/Detector.hpp"
+#include "core/geometry/DetectorIndex.hpp"
+#include "core/geometry/HybridPixelDetectorModel.hpp"
+#include "core/utils/unit.h"
+#include "tools/mobility.h"
+#include "tools/runge_kutta.h"
+
+using namespace allpix;
+
+namespace {
+    // Number of distinct positions cycled through by the benchmarks to avoid measuring a single cached lookup
+    constexpr size_t num_positions = 1024;
+
+    /**
+     * @brief Detector with an electric field and a weighting potential, both defined on grids
+     */
+    class FieldFixture {
+    public:
+        FieldFixture() {
+            std::istringstream model_config("type = \"hybrid\"\n"
+                                            "number_of_pixels = 256 256\n"
+                                            "pixel_size = 55um 55um\n"
+                                            "sensor_thickness = 300um\n"
+                                            "chip_thickness = 700um\n");
+            ConfigReader reader(model_config, "benchmark_model.conf");
+            auto model = std::make_shared<HybridPixelDetectorModel>("benchmark", reader);
+            detector = std::make_shared<Detector>("benchmark", model, ROOT::Math::XYZPoint(), ROOT::Math::Rotation3D());
+
+            auto pitch = model->getPixelSize();
+            auto sensor_center = model->getSensorCenter();
+            auto sensor_size = model->getSensorSize();
+            std::pair<double, double> thickness_domain(sensor_center.z() - sensor_size.z() / 2.0,
+                                                       sensor_center.z() + sensor_size.z() / 2.0);
+
+            // Electric field of a single pixel cell, linear in depth as for a simple planar sensor
+            std::array<size_t, 3> field_size{{55, 55, 300}};
+            auto field = std::make_shared<std::vector<double>>();
+            field->reserve(field_size[0] * field_size[1] * field_size[2] * 3);
+            for(size_t x = 0; x < field_size[0]; ++x) {
+                for(size_t y = 0; y < field_size[1]; ++y) {
+                    for(size_t z = 0; z < field_size[2]; ++z) {
+                        field->push_back(0);
+                        field->push_back(0);
+                        field->push_back(Units::get(-1000. * (1. + static_cast<double>(z) / 300.), "V/cm"));
+                    }
+                }
+            }
+            detector->setElectricFieldGrid(field, field_size, {{pitch.x(), pitch.y()}}, {{0, 0}}, thickness_domain);
+
+            // Weighting potential spanning five by five pixels around the reference pixel
+            std::array<size_t, 3> potential_size{{125, 125, 50}};
+            auto potential =
+                std::make_shared<std::vector<double>>(potential_size[0] * potential_size[1] * potential_size[2], 0.5);
+            detector->setWeightingPotentialGrid(
+                potential, potential_size, {{5 * pitch.x(), 5 * pitch.y()}}, {{0, 0}}, thickness_domain);
+
+            // Random positions inside the sensor, in a region of five by five pixels
+            std::mt19937_64 random_generator(0);
+            std::uniform_real_distribution<double> xy_distribution(-2.5, 2.5);
+            std::uniform_real_distribution<double> z_distribution(thickness_domain.first, thickness_domain.second);
+            positions.reserve(num_positions);
+            for(size_t i = 0; i < num_positions; ++i) {
+                positions.emplace_back(xy_distribution(random_generator) * pitch.x(),
+                                       xy_distribution(random_generator) * pitch.y(),
+                                       z_distribution(random_generator));
+            }
+        }
+
+        std::shared_ptr<Detector> detector;
+        std::vector<ROOT::Math::XYZPoint> positions;
+    };
+
+    // Fixture shared between all field benchmarks, created on first use after the units have been registered
+    FieldFixture& get_field_fixture() {
+        static FieldFixture fixture;
+        return fixture;
+    }
+} // namespace
+
+/**
+ * Lookup of the electric field, replicated and flipped for every pixel cell
+ */
+static void BM_DetectorFieldGet(benchmark::State& state) {
+    auto& fixture = get_field_fixture();
+
+    size_t index = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(fixture.detector->getElectricField(fixture.positions[index]));
+        index = (index + 1) % num_positions;
+    }
+}
+BENCHMARK(BM_DetectorFieldGet);
+
+/**
+ * Lookup of the weighting potential relative to a reference pixel
+ */
+static void BM_DetectorFieldGetRelativeTo(benchmark::State& state) {
+    auto& fixture = get_field_fixture();
+
+    size_t index = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(fixture.detector->getWeightingPotential(fixture.positions[index], {0, 0}));
+        index = (index + 1) % num_positions;
+    }
+}
+BENCHMARK(BM_DetectorFieldGetRelativeTo);
+
+/**
+ * Geometry queries done for every step of the charge carrier transport: sensor and implant containment and the conversion
+ * from global to local coordinates
+ */
+static void BM_DetectorGeometryQueries(benchmark::State& state) {
+    auto& fixture = get_field_fixture();
+
+    size_t index = 0;
+    for(auto _ : state) {
+        auto& pos = fixture.positions[index];
+        benchmark::DoNotOptimize(fixture.detector->isWithinSensor(pos));
+        benchmark::DoNotOptimize(fixture.detector->isWithinImplant(pos));
+        benchmark::DoNotOptimize(fixture.detector->getLocalPosition(pos));
+        index = (index + 1) % num_positions;
+    }
+}
+BENCHMARK(BM_DetectorGeometryQueries);
+
+/**
+ * Lookup of the detectors containing a global position, for a telescope with a varying number of planes along the beam
+ */
+static void BM_DetectorIndexLookup(benchmark::State& state) {
+    auto& fixture = get_field_fixture();
+    auto num_detectors = static_cast<size_t>(state.range(0));
+    auto spacing = Units::get(10.0, "mm");
+
+    std::vector<std::shared_ptr<Detector>> detectors;
+    detectors.reserve(num_detectors);
+    for(size_t i = 0; i < num_detectors; ++i) {
+        detectors.push_back(std::make_shared<Detector>("plane" + std::to_string(i),
+                                                       fixture.detector->getModel(),
+                                                       ROOT::Math::XYZPoint(0, 0, static_cast<double>(i) * spacing),
+                                                       ROOT::Math::Rotation3D()));
+    }
+    DetectorIndex detector_index;
+    detector_index.build(detectors);
+
+    // Random positions along the full telescope, mostly in between the planes
+    std::mt19937_64 random_generator(0);
+    std::uniform_real_distribution<double> z_distribution(0, static_cast<double>(num_detectors) * spacing);
+    std::vector<ROOT::Math::XYZPoint> positions;
+    positions.reserve(num_positions);
+    for(size_t i = 0; i < num_positions; ++i) {
+        positions.emplace_back(0, 0, z_distribution(random_generator));
+    }
+
+    size_t index = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(detector_index.findContaining(positions[index]));
+        index = (index + 1) % num_positions;
+    }
+}
+BENCHMARK(BM_DetectorIndexLookup)->Arg(8)->Arg(64)->Arg(512);
+
+/**
+ * Evaluation of the Jacoboni-Canali parameterization of the carrier mobility shared by the propagation modules
+ */
+static void BM_CarrierMobility(benchmark::State& state) {
+    JacoboniCanaliMobility mobility(293.15);
+
+    // Field magnitudes typically encountered in a depleted sensor
+    std::vector<double> field_magnitudes;
+    field_magnitudes.reserve(num_positions);
+    for(size_t i = 0; i < num_positions; ++i) {
+        field_magnitudes.push_back(Units::get(static_cast<double>(i) * 100., "V/cm"));
+    }
+
+    size_t index = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(mobility(CarrierType::ELECTRON, field_magnitudes[index]));
+        index = (index + 1) % num_positions;
+    }
+}
+BENCHMARK(BM_CarrierMobility);
+
+/**
+ * Single step of the Runge-Kutta-Fehlberg integration with a trivial step function, measuring the integrator only
+ */
+static void BM_RungeKuttaStep(benchmark::State& state) {
+    auto velocity = [](double, const Eigen::Vector3d& pos) -> Eigen::Vector3d { return -1e-3 * pos; };
+    auto runge_kutta = make_runge_kutta(tableau::RK5, velocity, 0.01, Eigen::Vector3d(1., 1., 1.));
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(runge_kutta.step());
+    }
+}
+BENCHMARK(BM_RungeKuttaStep);
+
+/**
+ * Single step of the charge carrier transport as done by the GenericPropagation module, using the electric field of the
+ * detector and the carrier mobility as step function
+ */
+static void BM_RungeKuttaStepElectricField(benchmark::State& state) {
+    auto& fixture = get_field_fixture();
+    JacoboniCanaliMobility mobility(293.15);
+
+    auto velocity = [&](double, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
+        auto raw_field = fixture.detector->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
+        Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
+        return -1 * mobility(CarrierType::ELECTRON, efield.norm()) * efield;
+    };
+    auto runge_kutta = make_runge_kutta(tableau::RK5, velocity, Units::get(0.01, "ns"), Eigen::Vector3d());
+
+    size_t index = 0;
+    for(auto _ : state) {
+        auto& pos = fixture.positions[index];
+        runge_kutta.setValue(Eigen::Vector3d(pos.x(), pos.y(), pos.z()));
+        benchmark::DoNotOptimize(runge_kutta.step());
+        index = (index + 1) % num_positions;
+    }
+}
+BENCHMARK(BM_RungeKuttaStepElectricField);
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @brief Micro-benchmarks of the signal formation and digitization: pulses, amplifier response and clustering
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "DetectorHistogrammer/Cluster.hpp"
+#include "core/utils/unit.h"
+#include "objects/PixelHit.hpp"
+#include "objects/Pulse.hpp"
+#include "tools/convolution.h"
+
+using namespace allpix;
+
+namespace {
+    // Number of distinct values cycled through by the benchmarks to avoid measuring a single cached value
+    constexpr size_t num_values = 1024;
+} // namespace
+
+/**
+ * Adding induced charge at random times to a pulse with 10ps binning and a total length of 20ns
+ */
+static void BM_PulseAddCharge(benchmark::State& state) {
+    std::mt19937_64 random_generator(0);
+    std::uniform_real_distribution<double> time_distribution(0, Units::get(20., "ns"));
+    std::vector<double> times;
+    times.reserve(num_values);
+    for(size_t i = 0; i < num_values; ++i) {
+        times.push_back(time_distribution(random_generator));
+    }
+
+    Pulse pulse(Units::get(10., "ps"));
+    size_t index = 0;
+    for(auto _ : state) {
+        pulse.addCharge(1., times[index]);
+        index = (index + 1) % num_values;
+    }
+    benchmark::DoNotOptimize(pulse.getPulse().data());
+}
+BENCHMARK(BM_PulseAddCharge);
+
+/**
+ * Amplification of a pulse of the given number of time bins with the default charge-sensitive amplifier response
+ */
+static void BM_CSAConvolution(benchmark::State& state) {
+    auto timestep = Units::get(10., "ps");
+    auto tmax = Units::get(100., "ns");
+    auto ntimepoints = static_cast<size_t>(std::ceil(tmax / timestep));
+
+    // Impulse response with the default parameters of the CSADigitizer module
+    auto tauF = Units::get(10e-9, "s");
+    auto tauR = Units::get(1e-9, "s");
+    auto resistance_feedback = tauF / Units::get(5e-15, "C/V");
+    std::vector<double> impulse_response;
+    impulse_response.reserve(ntimepoints);
+    for(size_t itimepoint = 0; itimepoint < ntimepoints; ++itimepoint) {
+        auto x = timestep * static_cast<double>(itimepoint);
+        impulse_response.push_back(resistance_feedback * (std::exp(-x / tauF) - std::exp(-x / tauR)) / (tauF - tauR));
+    }
+
+    // Pulse with the charge induced in all bins
+    std::vector<double> pulse_vec(static_cast<size_t>(state.range(0)), 1.);
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(convolve(pulse_vec, impulse_response));
+    }
+}
+BENCHMARK(BM_CSAConvolution)->Arg(100)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Clustering of the given number of pixel hits, grouped into clusters of two by two pixels spread over the matrix
+ */
+static void BM_Clustering(benchmark::State& state) {
+    auto num_hits = static_cast<size_t>(state.range(0));
+    auto pitch = Units::get(55., "um");
+
+    std::vector<PixelHit> pixel_hits;
+    pixel_hits.reserve(num_hits);
+    for(size_t i = 0; pixel_hits.size() < num_hits; ++i) {
+        auto seed_x = static_cast<unsigned int>(i % 64) * 4;
+        auto seed_y = static_cast<unsigned int>(i / 64) * 4;
+        for(unsigned int j = 0; j < 4 && pixel_hits.size() < num_hits; ++j) {
+            Pixel::Index index(seed_x + j % 2, seed_y + j / 2);
+            ROOT::Math::XYZPoint center(pitch * index.x(), pitch * index.y(), 0);
+            pixel_hits.emplace_back(Pixel(index, center, center, {pitch, pitch}), 0., 1000.);
+        }
+    }
+
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(Cluster::findClusters(pixel_hits));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Clustering)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
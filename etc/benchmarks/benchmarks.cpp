@@ -0,0 +1,30 @@
+/**
+ * @file
+ * @brief Entry point of the micro-benchmarks of the framework hot paths
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "core/utils/log.h"
+#include "tools/units.h"
+
+int main(int argc, char** argv) {
+    // Only report problems, the benchmarks should not measure the writing of log messages
+    allpix::Log::setReportingLevel(allpix::LogLevel::ERROR);
+
+    // Register the framework units as done by the framework before loading the configuration
+    allpix::register_units();
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Compare two sets of micro-benchmark results written by Google Benchmark in JSON format.
+
+The CPU time of every benchmark present in both files is compared. If repetitions were run, the median is used. The script
+exits with a non-zero code if any benchmark is slower than the baseline by more than the given relative tolerance.
+
+Usage: compare_benchmarks.py <baseline.json> <results.json> [--tolerance 0.10]
+"""
+
+import argparse
+import json
+import sys
+
+# Conversion of the time units used by Google Benchmark to nanoseconds
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_results(file_name):
+    """Return the CPU time in nanoseconds of all benchmarks in a file, preferring the median of repeated runs."""
+    with open(file_name) as results_file:
+        data = json.load(results_file)
+
+    times = {}
+    for entry in data["benchmarks"]:
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") != "median":
+                continue
+            name = entry["run_name"]
+        else:
+            name = entry.get("run_name", entry["name"])
+            # Only use single iterations if no median is available
+            if name in times:
+                continue
+        times[name] = entry["cpu_time"] * TIME_UNITS[entry.get("time_unit", "ns")]
+    return times
+
+
+def format_time(time):
+    for unit in ("s", "ms", "us"):
+        if time >= TIME_UNITS[unit]:
+            return "{:.3g} {}".format(time / TIME_UNITS[unit], unit)
+    return "{:.3g} ns".format(time)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare micro-benchmark results to a baseline")
+    parser.add_argument("baseline", help="JSON file with the baseline results")
+    parser.add_argument("results", help="JSON file with the results to compare")
+    parser.add_argument("--tolerance", type=float, default=0.10, help="tolerated relative slow-down (default: 0.10)")
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    results = load_results(args.results)
+
+    regressions = []
+    name_width = max([len(name) for name in results] + [len("Benchmark")])
+    print("{:<{w}}  {:>12}  {:>12}  {:>8}".format("Benchmark", "Baseline", "Current", "Change", w=name_width))
+    for name, time in results.items():
+        if name not in baseline:
+            print("{:<{w}}  {:>12}  {:>12}  {:>8}".format(name, "-", format_time(time), "new", w=name_width))
+            continue
+
+        change = time / baseline[name] - 1.0
+        status = ""
+        if change > args.tolerance:
+            regressions.append(name)
+            status = "  REGRESSION"
+        print("{:<{w}}  {:>12}  {:>12}  {:>+7.1f}%{}".format(
+            name, format_time(baseline[name]), format_time(time), 100 * change, status, w=name_width))
+
+    for name in baseline:
+        if name not in results:
+            print("{:<{w}}  {:>12}  {:>12}  {:>8}".format(name, format_time(baseline[name]), "-", "missing", w=name_width))
+
+    if regressions:
+        print("\n{} benchmark(s) slower than the baseline by more than {:.0f}%: {}".format(
+            len(regressions), 100 * args.tolerance, ", ".join(regressions)))
+        return 1
+
+    print("\nNo benchmark slower than the baseline by more than {:.0f}%".format(100 * args.tolerance))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
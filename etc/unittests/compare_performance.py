@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Compare the performance report written by a simulation run to the report of a baseline run.
+
+The test fails if the event rate dropped or the peak resident memory grew by more than the given relative tolerance. The
+share of the execution time spent in every module instantiation is printed for information. If no baseline report exists,
+the comparison is skipped by returning the exit code 77.
+
+Usage: compare_performance.py <report.json> <baseline.json> [--tolerance 0.15]
+"""
+
+import argparse
+import json
+import os
+import sys
+
+# Exit code indicating a skipped comparison to CTest
+SKIP_RETURN_CODE = 77
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare a performance report to a baseline")
+    parser.add_argument("report", help="performance report of the current run")
+    parser.add_argument("baseline", help="performance report of the baseline run")
+    parser.add_argument("--tolerance", type=float, default=0.15, help="tolerated relative regression (default: 0.15)")
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.baseline):
+        print("No baseline report {} available, skipping comparison".format(args.baseline))
+        return SKIP_RETURN_CODE
+
+    with open(args.report) as report_file:
+        report = json.load(report_file)
+    with open(args.baseline) as baseline_file:
+        baseline = json.load(baseline_file)
+
+    # Only reports of identical setups can be compared
+    for key in ("number_of_events", "workers"):
+        if report[key] != baseline[key]:
+            print("Cannot compare to baseline: {} differs ({} instead of {}), the baseline should be updated".format(
+                key, report[key], baseline[key]))
+            return 1
+
+    regressions = []
+
+    change = report["events_per_second"] / baseline["events_per_second"] - 1.0
+    print("Event rate:   {:10.2f} Hz (baseline {:10.2f} Hz, {:+.1f}%)".format(
+        report["events_per_second"], baseline["events_per_second"], 100 * change))
+    if change < -args.tolerance:
+        regressions.append("event rate")
+
+    change = report["peak_memory"] / baseline["peak_memory"] - 1.0
+    print("Peak memory:  {:10.1f} MB (baseline {:10.1f} MB, {:+.1f}%)".format(
+        report["peak_memory"] / 1e6, baseline["peak_memory"] / 1e6, 100 * change))
+    if change > args.tolerance:
+        regressions.append("peak memory")
+
+    print("\nShare of the execution time per module instantiation:")
+    name_width = max(len(name) for name in report["modules"])
+    for name, module in report["modules"].items():
+        if name in baseline["modules"]:
+            baseline_share = "{:5.1f}%".format(100 * baseline["modules"][name]["share"])
+        else:
+            baseline_share = "  new"
+        print("  {:<{w}}  {:5.1f}% (baseline {})".format(name, 100 * module["share"], baseline_share, w=name_width))
+
+    if regressions:
+        print("\nRegression beyond the tolerance of {:.0f}% in: {}".format(100 * args.tolerance, ", ".join(regressions)))
+        return 1
+
+    print("\nNo regression beyond the tolerance of {:.0f}%".format(100 * args.tolerance))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Consume the stream written by the StreamWriter module of a simulation run.
+
+Starts the simulation, connects to its socket as soon as it accepts connections and reads all frames until the frame
+marking the end of the stream. The number of events received is printed, such that the test can check the output of
+both the simulation and the consumer. The exit code of the simulation is returned, or one if the stream was incomplete.
+
+Usage: stream_consumer.py <socket path> <simulation command...>
+"""
+
+import socket
+import struct
+import subprocess
+import sys
+import time
+
+# Time to wait for the simulation to accept the connection, in seconds
+CONNECT_TIMEOUT = 60
+
+
+def read_exact(connection, size):
+    """Read exactly size bytes from the connection, returns None if the stream is closed before"""
+    data = b""
+    while len(data) < size:
+        chunk = connection.recv(size - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 1
+    path = sys.argv[1]
+    simulation = subprocess.Popen(sys.argv[2:])
+
+    # Retry until the socket has been created, a socket left from a previous run refuses the connection
+    connection = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    deadline = time.time() + CONNECT_TIMEOUT
+    while True:
+        try:
+            connection.connect(path)
+            break
+        except OSError:
+            if simulation.poll() is not None or time.time() > deadline:
+                print("Consumer could not connect to stream {}".format(path))
+                simulation.wait()
+                return 1
+            time.sleep(0.01)
+
+    # The first frame contains the header, every following frame a single event
+    frames = 0
+    complete = False
+    while True:
+        size = read_exact(connection, 4)
+        if size is None:
+            break
+        size = struct.unpack("<I", size)[0]
+        if size == 0:
+            complete = True
+            break
+        if read_exact(connection, size) is None:
+            break
+        frames += 1
+    connection.close()
+
+    return_code = simulation.wait()
+    if not complete or frames == 0:
+        print("Consumer received incomplete stream with {} frames".format(frames))
+        return 1
+    print("Consumer received header and {} events".format(frames - 1))
+    return return_code
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -92,6 +92,12 @@ Allpix::Allpix(std::string config_file_name,
         Log::addStream(log_file_);
     }
 
+    // Pass log messages to a background thread if requested
+    if(global_config.get<bool>("log_asynchronous", false)) {
+        Log::setAsynchronous(true);
+        LOG(TRACE) << "Enabled asynchronous writing of log messages";
+    }
+
     // Wait for the first detailed messages until level and format are properly set
     LOG(TRACE) << "Global log level is set to " << log_level_string;
     LOG(TRACE) << "Global log format is set to " << log_format_string;
@@ -164,7 +170,8 @@ void Allpix::load() {
     // Use existing output directory if it exists
     bool create_output_dir = true;
     if(allpix::path_is_directory(directory)) {
-        if(global_config.get<bool>("purge_output_directory", false)) {
+        // Keep the output written before the checkpoint if the simulation is resumed
+        if(global_config.get<bool>("purge_output_directory", false) && !global_config.get<bool>("resume", false)) {
             LOG(DEBUG) << "Deleting previous output directory " << directory;
             allpix::remove_path(directory);
         } else {
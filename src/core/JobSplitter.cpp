@@ -0,0 +1,418 @@
+/** @file
+ *  @brief Implementation of the splitting of a simulation into several worker processes
+ *  @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "JobSplitter.hpp"
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TFileMerger.h>
+#include <TKey.h>
+#include <TSystem.h>
+#include <TTree.h>
+#include <TVirtualCollectionProxy.h>
+
+#include "core/utils/exceptions.h"
+#include "core/utils/file.h"
+#include "core/utils/log.h"
+
+using namespace allpix;
+
+JobSplitter::JobSplitter(std::string config_file_name,
+                         std::vector<std::string> module_options,
+                         std::vector<std::string> detector_options,
+                         unsigned int workers)
+    : module_options_(std::move(module_options)), detector_options_(std::move(detector_options)) {
+    // Load the global configuration in the same way as the framework
+    conf_mgr_ = std::make_unique<ConfigManager>(config_file_name,
+                                                std::initializer_list<std::string>({"Allpix", ""}),
+                                                std::initializer_list<std::string>({"Ignore"}));
+    conf_mgr_->loadModuleOptions(module_options_);
+    conf_mgr_->loadDetectorOptions(detector_options_);
+    config_file_name_ = std::move(config_file_name);
+
+    Configuration& global_config = conf_mgr_->getGlobalConfiguration();
+    if(Log::getReportingLevel() == LogLevel::NONE) {
+        try {
+            auto log_level_string = global_config.get<std::string>("log_level", "INFO");
+            std::transform(log_level_string.begin(), log_level_string.end(), log_level_string.begin(), ::toupper);
+            Log::setReportingLevel(Log::getLevelFromString(log_level_string));
+        } catch(std::invalid_argument& e) {
+            Log::setReportingLevel(LogLevel::INFO);
+        }
+    }
+
+    // Use a seed from the system entropy if none is configured, all workers use the same seed
+    if(global_config.has("random_seed")) {
+        seed_ = global_config.get<uint64_t>("random_seed");
+    } else {
+        std::random_device entropy;
+        seed_ = (static_cast<uint64_t>(entropy()) << 32u) ^ entropy();
+        LOG(STATUS) << "Using system entropy seed " << seed_ << " for the workers";
+    }
+    core_seed_ = global_config.get<uint64_t>("random_seed_core", seed_ + 1);
+
+    // Distribute the events evenly in consecutive ranges, the first workers simulate the remaining events
+    number_of_events_ = global_config.get<unsigned int>("number_of_events", 1u);
+    auto first_event = global_config.get<unsigned int>("skip_events", 0u);
+    if(first_event > number_of_events_) {
+        throw InvalidValueError(global_config, "skip_events", "cannot skip more events than the number of events");
+    }
+    auto events = number_of_events_ - first_event;
+    workers = std::max(std::min(workers, events), 1u);
+    for(unsigned int i = 0; i < workers; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->first_event = first_event;
+        worker->events = events / workers + (i < events % workers ? 1 : 0);
+        first_event += worker->events;
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void JobSplitter::run(const std::string& executable) {
+    Configuration& global_config = conf_mgr_->getGlobalConfiguration();
+
+    // Determine the output directory in the same way as the framework
+    std::string directory = gSystem->pwd();
+    directory += "/output";
+    if(global_config.has("output_directory")) {
+        directory = global_config.getPath("output_directory");
+    }
+
+    LOG(STATUS) << "Splitting events " << (workers_.front()->first_event + 1) << " to " << number_of_events_ << " into "
+                << workers_.size() << " worker processes";
+    for(size_t i = 0; i < workers_.size(); ++i) {
+        auto& worker = *workers_[i];
+        worker.directory = directory + "/worker_" + std::to_string(i);
+        try {
+            allpix::create_directories(worker.directory);
+        } catch(std::invalid_argument& e) {
+            throw RuntimeError("Cannot create output directory " + worker.directory + ": " + e.what());
+        }
+
+        LOG(INFO) << "Starting worker " << i << " with events " << (worker.first_event + 1) << " to "
+                  << (worker.first_event + worker.events);
+        start_worker(executable, worker);
+    }
+
+    // Wait for all workers, retrying if the wait is interrupted by a signal
+    bool failed = false;
+    for(size_t i = 0; i < workers_.size(); ++i) {
+        auto& worker = *workers_[i];
+        int status = 0;
+        pid_t result = 0;
+        do {
+            result = waitpid(worker.pid, &status, 0);
+        } while(result == -1 && errno == EINTR);
+
+        if(result == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            LOG(ERROR) << "Worker " << i << " failed, see its log in " << worker.directory << "/output.log";
+            failed = true;
+        } else {
+            LOG(INFO) << "Worker " << i << " finished";
+        }
+    }
+    if(failed) {
+        throw RuntimeError("Not all worker processes finished successfully, cannot merge their output");
+    }
+
+    merge_output(directory);
+}
+
+/*
+ * This function can be called safely from any signal handler. The workers finish their current event and write their
+ * output, which is merged afterwards.
+ */
+void JobSplitter::terminate() {
+    for(auto& worker : workers_) {
+        pid_t pid = worker->pid;
+        if(pid > 0) {
+            kill(pid, SIGTERM);
+        }
+    }
+}
+
+/**
+ * The workers are started with the same configuration and options as the splitter itself. Only the range of events and the
+ * output directory are overwritten, the random seeds are fixed to the ones of the splitter and derived per event. The
+ * standard output of every worker is written to a log file in its output directory.
+ */
+void JobSplitter::start_worker(const std::string& executable, Worker& worker) {
+    Configuration& global_config = conf_mgr_->getGlobalConfiguration();
+
+    std::vector<std::string> arguments{executable, "-c", config_file_name_};
+    arguments.emplace_back("-v");
+    arguments.push_back(Log::getStringFromLevel(Log::getReportingLevel()));
+    auto options = module_options_;
+    options.push_back("number_of_events=" + std::to_string(worker.first_event + worker.events));
+    options.push_back("skip_events=" + std::to_string(worker.first_event));
+    options.push_back("random_seed=" + std::to_string(seed_));
+    options.push_back("event_seeds=true");
+    options.push_back("random_seed_core=" + std::to_string(core_seed_));
+    options.push_back("output_directory=\"" + worker.directory + "\"");
+    if(global_config.has("log_file")) {
+        options.push_back("log_file=\"" + worker.directory + "/log.txt\"");
+    }
+    for(auto& option : options) {
+        arguments.emplace_back("-o");
+        arguments.push_back(option);
+    }
+    for(auto& option : detector_options_) {
+        arguments.emplace_back("-g");
+        arguments.push_back(option);
+    }
+
+    // Prepare everything before forking, only async-signal-safe functions can be used in the child
+    std::vector<char*> argv;
+    for(auto& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str())); // NOLINT
+    }
+    argv.push_back(nullptr);
+    auto log_file = worker.directory + "/output.log";
+
+    pid_t pid = fork();
+    if(pid == -1) {
+        throw RuntimeError("Cannot start worker process: " + std::string(std::strerror(errno)));
+    }
+    if(pid == 0) {
+        int log_descriptor = open(log_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644); // NOLINT
+        if(log_descriptor != -1) {
+            dup2(log_descriptor, STDOUT_FILENO);
+            dup2(log_descriptor, STDERR_FILENO);
+            close(log_descriptor);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127);
+    }
+    worker.pid = pid;
+}
+
+/**
+ * Only the files in the top level of the output directories are merged, which includes the main ROOT file with the
+ * histograms of all modules and the output of the ROOTObjectWriter. Other files are kept in the output directories of the
+ * workers.
+ */
+void JobSplitter::merge_output(const std::string& directory) {
+    auto files = allpix::get_files_in_directory(workers_.front()->directory);
+    std::sort(files.begin(), files.end());
+    for(auto& file : files) {
+        auto name = file.substr(file.find_last_of('/') + 1);
+        if(name == "output.log") {
+            continue;
+        }
+        if(allpix::get_file_name_extension(name).second != ".root") {
+            LOG(WARNING) << "Cannot merge " << name << ", it is only available in the output directories of the workers";
+            continue;
+        }
+
+        std::vector<std::string> inputs;
+        for(auto& worker : workers_) {
+            inputs.push_back(worker->directory + "/" + name);
+        }
+        if(!std::all_of(inputs.begin(), inputs.end(), [](const auto& input) { return allpix::path_is_file(input); })) {
+            LOG(WARNING) << "Cannot merge " << name << ", it has not been written by all workers";
+            continue;
+        }
+
+        // Files written by the ROOTObjectWriter contain the configuration of the simulation
+        bool objects = false;
+        {
+            TFile input_file(inputs.front().c_str());
+            objects = (input_file.GetDirectory("config/Allpix") != nullptr);
+        }
+
+        auto output = directory + "/" + name;
+        if(objects) {
+            merge_objects(inputs, output);
+        } else {
+            merge_histograms(inputs, output);
+        }
+        LOG(STATUS) << "Merged " << name << " of " << workers_.size() << " workers into " << output;
+    }
+}
+
+void JobSplitter::merge_histograms(const std::vector<std::string>& inputs, const std::string& output) {
+    TFileMerger merger(false, false);
+    merger.SetPrintLevel(0);
+    if(!merger.OutputFile(output.c_str(), "RECREATE")) {
+        throw RuntimeError("Cannot create merged file " + output);
+    }
+    for(auto& input : inputs) {
+        if(!merger.AddFile(input.c_str(), false)) {
+            throw RuntimeError("Cannot read file " + input + " to merge");
+        }
+    }
+    if(!merger.Merge()) {
+        throw RuntimeError("Cannot merge histograms into " + output);
+    }
+}
+
+/**
+ * The trees of all workers are concatenated entry by entry. Trees and branches are created lazily by the writer when the
+ * first object of a type is dispatched, such that they can be missing in the output of some workers. Empty entries are
+ * filled for those to keep the entries of all trees aligned to the events. The configuration is copied from the first
+ * worker with the number of events of the full simulation.
+ */
+void JobSplitter::merge_objects(const std::vector<std::string>& inputs, const std::string& output) {
+    std::vector<std::unique_ptr<TFile>> input_files;
+    for(auto& input : inputs) {
+        auto input_file = std::make_unique<TFile>(input.c_str());
+        if(input_file->IsZombie()) {
+            throw RuntimeError("Cannot read file " + input + " to merge");
+        }
+        input_files.push_back(std::move(input_file));
+    }
+
+    // Collect the structure of all trees, the title of the tree and the class of every branch
+    std::map<std::string, std::pair<std::string, std::map<std::string, std::string>>> structure;
+    for(auto& input_file : input_files) {
+        for(auto&& object : *input_file->GetListOfKeys()) {
+            auto& key = dynamic_cast<TKey&>(*object);
+            if(std::string(key.GetClassName()) != "TTree") {
+                continue;
+            }
+            auto* tree = dynamic_cast<TTree*>(input_file->Get(key.GetName()));
+            auto& tree_structure = structure[tree->GetName()];
+            tree_structure.first = tree->GetTitle();
+            for(auto&& branch_object : *tree->GetListOfBranches()) {
+                auto& branch = dynamic_cast<TBranch&>(*branch_object);
+                tree_structure.second[branch.GetName()] = branch.GetClassName();
+            }
+        }
+    }
+
+    TFile output_file(output.c_str(), "RECREATE");
+    if(output_file.IsZombie()) {
+        throw RuntimeError("Cannot create merged file " + output);
+    }
+    for(auto& tree_structure : structure) {
+        output_file.cd();
+        auto* output_tree = new TTree(tree_structure.first.c_str(), tree_structure.second.first.c_str());
+
+        // Every branch writes either the objects read from a worker or an empty collection
+        struct Buffers {
+            TClass* cls{};
+            void* output{};
+            void* input{};
+            void* empty{};
+            bool present{};
+        };
+        std::map<std::string, Buffers> buffers;
+        for(auto& branch : tree_structure.second.second) {
+            auto& buffer = buffers[branch.first];
+            buffer.cls = TClass::GetClass(branch.second.c_str());
+            if(buffer.cls == nullptr || buffer.cls->GetCollectionProxy() == nullptr) {
+                throw RuntimeError("Cannot merge branch " + branch.first + " of unknown type " + branch.second);
+            }
+            buffer.input = buffer.cls->New();
+            buffer.empty = buffer.cls->New();
+            buffer.output = buffer.empty;
+            output_tree->Bronch(branch.first.c_str(), branch.second.c_str(), &buffer.output);
+        }
+
+        for(size_t i = 0; i < input_files.size(); ++i) {
+            auto* input_tree = dynamic_cast<TTree*>(input_files[i]->Get(tree_structure.first.c_str()));
+            if(input_tree == nullptr) {
+                LOG(DEBUG) << "Filling " << workers_[i]->events << " empty events into tree " << tree_structure.first
+                           << " for worker " << i;
+                for(auto& buffer : buffers) {
+                    buffer.second.output = buffer.second.empty;
+                }
+                for(unsigned int event = 0; event < workers_[i]->events; ++event) {
+                    output_tree->Fill();
+                }
+                continue;
+            }
+
+            for(auto& buffer : buffers) {
+                buffer.second.present = (input_tree->GetBranch(buffer.first.c_str()) != nullptr);
+                buffer.second.output = (buffer.second.present ? buffer.second.input : buffer.second.empty);
+                if(buffer.second.present) {
+                    input_tree->SetBranchAddress(buffer.first.c_str(), &buffer.second.input);
+                }
+            }
+            for(Long64_t entry = 0; entry < input_tree->GetEntries(); ++entry) {
+                input_tree->GetEntry(entry);
+                output_tree->Fill();
+
+                // Delete the objects read for this entry, the collections only hold pointers to them
+                for(auto& buffer : buffers) {
+                    if(buffer.second.present) {
+                        auto* proxy = buffer.second.cls->GetCollectionProxy();
+                        TVirtualCollectionProxy::TPushPop helper(proxy, buffer.second.input);
+                        proxy->Clear("force");
+                    }
+                }
+            }
+            input_tree->ResetBranchAddresses();
+        }
+
+        output_tree->Write();
+        for(auto& buffer : buffers) {
+            buffer.second.cls->Destructor(buffer.second.input);
+            buffer.second.cls->Destructor(buffer.second.empty);
+        }
+    }
+
+    // Copy the configuration and update the parameters that differ between the workers
+    copy_directory(input_files.front().get(), &output_file);
+    auto* global_dir = output_file.GetDirectory("config/Allpix");
+    if(global_dir != nullptr) {
+        Configuration& global_config = conf_mgr_->getGlobalConfiguration();
+        std::map<std::string, std::string> parameters{{"number_of_events", std::to_string(number_of_events_)}};
+        if(global_config.has("output_directory")) {
+            parameters["output_directory"] = global_config.getText("output_directory");
+        }
+        for(auto& parameter : parameters) {
+            global_dir->WriteObject(&parameter.second, parameter.first.c_str(), "Overwrite");
+        }
+    }
+    output_file.Close();
+}
+
+void JobSplitter::copy_directory(TDirectory* source, TDirectory* target) {
+    std::set<std::string> names;
+    for(auto&& object : *source->GetListOfKeys()) {
+        auto& key = dynamic_cast<TKey&>(*object);
+        std::string class_name = key.GetClassName();
+
+        // Only the latest cycle of every key is copied, the trees are merged separately
+        if(class_name == "TTree" || !names.insert(key.GetName()).second) {
+            continue;
+        }
+
+        if(class_name == "TDirectoryFile" || class_name == "TDirectory") {
+            auto* target_dir = target->mkdir(key.GetName());
+            copy_directory(source->GetDirectory(key.GetName()), target_dir);
+            continue;
+        }
+
+        auto* cls = TClass::GetClass(class_name.c_str());
+        auto* data = key.ReadObjectAny(cls);
+        if(data == nullptr) {
+            LOG(WARNING) << "Cannot copy " << key.GetName() << " of type " << class_name << " into merged file";
+            continue;
+        }
+        target->WriteObjectAny(data, cls, key.GetName());
+        cls->Destructor(data);
+    }
+}
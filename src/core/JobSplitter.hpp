@@ -0,0 +1,123 @@
+/** @file
+ *  @brief Splitting of a simulation into several worker processes
+ *  @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_JOB_SPLITTER_H
+#define ALLPIX_JOB_SPLITTER_H
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "config/ConfigManager.hpp"
+
+class TDirectory;
+
+namespace allpix {
+    /**
+     * @ingroup Managers
+     * @brief Runs a simulation split into several independent worker processes and merges their output
+     *
+     * The events of the simulation are distributed evenly over worker processes of the executable, which are started with
+     * the same configuration but with their own range of events and output directory. All workers share the random seeds
+     * of the simulation and skip the events before their range. Since the random numbers of the modules are derived from
+     * the seed and the number of the event, a split simulation reproduces a single run independent of the number of
+     * workers.
+     *
+     * After all workers finished, the ROOT files in the output directories of the workers are merged into the main output
+     * directory. Histograms are summed, while the trees of objects written by the ROOTObjectWriter are concatenated in the
+     * order of the workers, such that the events are numbered consecutively like in a single run.
+     */
+    class JobSplitter {
+    public:
+        /**
+         * @brief Construct the splitter and load the configuration of the simulation
+         * @param config_file_name Path of the main configuration file
+         * @param module_options List of extra configuration options passed to all workers
+         * @param detector_options List of extra detector options passed to all workers
+         * @param workers Number of worker processes to start
+         */
+        JobSplitter(std::string config_file_name,
+                    std::vector<std::string> module_options,
+                    std::vector<std::string> detector_options,
+                    unsigned int workers);
+
+        /**
+         * @brief Run the workers, wait for them to finish and merge their output
+         * @param executable Path of the executable to start the workers with
+         * @throws RuntimeError If a worker cannot be started, fails or its output cannot be merged
+         */
+        void run(const std::string& executable);
+
+        /**
+         * @brief Request all workers to terminate after their current event
+         * @note Can be called safely from a signal handler
+         */
+        void terminate();
+
+    private:
+        /**
+         * @brief State of a single worker process
+         */
+        struct Worker {
+            std::string directory;
+            unsigned int first_event{};
+            unsigned int events{};
+            std::atomic<pid_t> pid{0};
+        };
+
+        /**
+         * @brief Start the process of a worker
+         * @param executable Path of the executable
+         * @param worker Worker to start
+         */
+        void start_worker(const std::string& executable, Worker& worker);
+
+        /**
+         * @brief Merge the ROOT files written by all workers into the main output directory
+         * @param directory Main output directory
+         */
+        void merge_output(const std::string& directory);
+
+        /**
+         * @brief Merge files by summing their histograms
+         * @param inputs Paths of the files written by the workers
+         * @param output Path of the merged file
+         */
+        static void merge_histograms(const std::vector<std::string>& inputs, const std::string& output);
+
+        /**
+         * @brief Merge files written by the ROOTObjectWriter by concatenating their trees
+         * @param inputs Paths of the files written by the workers
+         * @param output Path of the merged file
+         */
+        void merge_objects(const std::vector<std::string>& inputs, const std::string& output);
+
+        /**
+         * @brief Recursively copy all objects except trees from one directory to another
+         * @param source Directory to copy from
+         * @param target Directory to copy to
+         */
+        static void copy_directory(TDirectory* source, TDirectory* target);
+
+        std::unique_ptr<ConfigManager> conf_mgr_;
+        std::string config_file_name_;
+        std::vector<std::string> module_options_;
+        std::vector<std::string> detector_options_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        uint64_t seed_{};
+        uint64_t core_seed_{};
+        unsigned int number_of_events_{};
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_JOB_SPLITTER_H */
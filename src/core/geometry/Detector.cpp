@@ -8,6 +8,7 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <cmath>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -72,6 +73,19 @@ void Detector::build_transform() {
     ROOT::Math::Transform3D transform_local(translation_local);
     // Compute total transform local to global by first transforming local to locally centered and then to global coordinates
     transform_ = transform_center * transform_local.Inverse();
+    inverse_transform_ = transform_.Inverse();
+
+    // Cache the geometry derived from the model
+    geometry_.sensor_center = model_->getSensorCenter();
+    geometry_.sensor_half_size = model_->getSensorSize() / 2.0;
+    geometry_.pixel_size = model_->getPixelSize();
+    geometry_.inverse_pixel_size_x = 1.0 / geometry_.pixel_size.x();
+    geometry_.inverse_pixel_size_y = 1.0 / geometry_.pixel_size.y();
+    geometry_.implant_half_size_x = std::fabs(model_->getImplantSize().x() / 2);
+    geometry_.implant_half_size_y = std::fabs(model_->getImplantSize().y() / 2);
+    geometry_.pixel_z = geometry_.sensor_center.z() - geometry_.sensor_half_size.z();
+    geometry_.n_pixels_x = model_->getNPixels().x();
+    geometry_.n_pixels_y = model_->getNPixels().y();
 }
 
 std::string Detector::getName() const {
@@ -98,7 +112,7 @@ ROOT::Math::Rotation3D Detector::getOrientation() const {
  * The origin of the local frame is at the center of the first pixel in the middle of the sensor.
  */
 ROOT::Math::XYZPoint Detector::getLocalPosition(const ROOT::Math::XYZPoint& global_pos) const {
-    return transform_.Inverse()(global_pos);
+    return inverse_transform_(global_pos);
 }
 ROOT::Math::XYZPoint Detector::getGlobalPosition(const ROOT::Math::XYZPoint& local_pos) const {
     return transform_(local_pos);
@@ -108,11 +122,9 @@ ROOT::Math::XYZPoint Detector::getGlobalPosition(const ROOT::Math::XYZPoint& loc
  * The definition of inside the sensor is determined by the detector model
  */
 bool Detector::isWithinSensor(const ROOT::Math::XYZPoint& local_pos) const {
-    auto sensor_center = model_->getSensorCenter();
-    auto sensor_size = model_->getSensorSize();
-    return (2 * std::fabs(local_pos.z() - sensor_center.z()) <= sensor_size.z()) &&
-           (2 * std::fabs(local_pos.y() - sensor_center.y()) <= sensor_size.y()) &&
-           (2 * std::fabs(local_pos.x() - sensor_center.x()) <= sensor_size.x());
+    return (std::fabs(local_pos.z() - geometry_.sensor_center.z()) <= geometry_.sensor_half_size.z()) &&
+           (std::fabs(local_pos.y() - geometry_.sensor_center.y()) <= geometry_.sensor_half_size.y()) &&
+           (std::fabs(local_pos.x() - geometry_.sensor_center.x()) <= geometry_.sensor_half_size.x());
 }
 
 /**
@@ -121,29 +133,30 @@ bool Detector::isWithinSensor(const ROOT::Math::XYZPoint& local_pos) const {
  * @note The pixel implant currently is always positioned symmetrically, in the center of the pixel cell.
  */
 bool Detector::isWithinImplant(const ROOT::Math::XYZPoint& local_pos) const {
-
-    auto x_mod_pixel = std::fmod(local_pos.x() + model_->getPixelSize().x() / 2, model_->getPixelSize().x()) -
-                       model_->getPixelSize().x() / 2;
-    auto y_mod_pixel = std::fmod(local_pos.y() + model_->getPixelSize().y() / 2, model_->getPixelSize().y()) -
-                       model_->getPixelSize().y() / 2;
-
-    return (std::fabs(x_mod_pixel) <= std::fabs(model_->getImplantSize().x() / 2) &&
-            std::fabs(y_mod_pixel) <= std::fabs(model_->getImplantSize().y() / 2));
+    // Position relative to the pixel center, truncating towards zero like a floating point modulo
+    auto mod_pixel = [](double pos, double pitch, double inverse_pitch) {
+        auto shifted = pos + pitch / 2;
+        return shifted - std::trunc(shifted * inverse_pitch) * pitch - pitch / 2;
+    };
+    auto x_mod_pixel = mod_pixel(local_pos.x(), geometry_.pixel_size.x(), geometry_.inverse_pixel_size_x);
+    auto y_mod_pixel = mod_pixel(local_pos.y(), geometry_.pixel_size.y(), geometry_.inverse_pixel_size_y);
+
+    return (std::fabs(x_mod_pixel) <= geometry_.implant_half_size_x &&
+            std::fabs(y_mod_pixel) <= geometry_.implant_half_size_y);
 }
 
 /**
  * The definition of the pixel grid size is determined by the detector model
  */
 bool Detector::isWithinPixelGrid(const Pixel::Index& pixel_index) const {
-    return !(pixel_index.x() >= model_->getNPixels().x() || pixel_index.y() >= model_->getNPixels().y());
+    return !(pixel_index.x() >= geometry_.n_pixels_x || pixel_index.y() >= geometry_.n_pixels_y);
 }
 
 /**
  * The definition of the pixel grid size is determined by the detector model
  */
 bool Detector::isWithinPixelGrid(const int x, const int y) const {
-    return !(x < 0 || x >= static_cast<int>(model_->getNPixels().x()) || y < 0 ||
-             y >= static_cast<int>(model_->getNPixels().y()));
+    return !(x < 0 || x >= static_cast<int>(geometry_.n_pixels_x) || y < 0 || y >= static_cast<int>(geometry_.n_pixels_y));
 }
 
 /**
@@ -158,12 +171,12 @@ Pixel Detector::getPixel(unsigned int x, unsigned int y) const {
  * The pixel has internal information about the size and location specific for this detector
  */
 Pixel Detector::getPixel(const Pixel::Index& index) const {
-    auto size = model_->getPixelSize();
+    auto size = geometry_.pixel_size;
 
     // WARNING This relies on the origin of the local coordinate system
     auto local_x = size.x() * index.x();
     auto local_y = size.y() * index.y();
-    auto local_z = model_->getSensorCenter().z() - model_->getSensorSize().z() / 2.0;
+    auto local_z = geometry_.pixel_z;
 
     auto local_center = ROOT::Math::XYZPoint(local_x, local_y, local_z);
     auto global_center = getGlobalPosition(local_center);
@@ -187,6 +200,25 @@ ROOT::Math::XYZVector Detector::getElectricField(const ROOT::Math::XYZPoint& pos
     return electric_field_.get(pos);
 }
 
+/**
+ * The electric field at the given time is interpolated between the adjacent time slices. Without time slices, the static
+ * electric field is returned.
+ */
+ROOT::Math::XYZVector Detector::getElectricField(const ROOT::Math::XYZPoint& pos, double time) const {
+    if(!transient_electric_field_.isValid()) {
+        return electric_field_.get(pos);
+    }
+    return transient_electric_field_.get(pos, time);
+}
+
+bool Detector::hasTransientElectricField() const {
+    return transient_electric_field_.isValid();
+}
+
+const TimeSlicedField<ROOT::Math::XYZVector, 3>& Detector::getTransientElectricField() const {
+    return transient_electric_field_;
+}
+
 /**
  * The type of the electric field is set depending on the function used to apply it.
  */
@@ -205,6 +237,29 @@ void Detector::setElectricFieldGrid(const std::shared_ptr<std::vector<double>>&
     electric_field_.setGrid(field, dimensions, scales, offset, thickness_domain);
 }
 
+/**
+ * @throws std::invalid_argument If the time of the slice is not after the time of the previous slice
+ *
+ * The grid of the slice is only requested from the loader when the field is queried at a time requiring this slice. The
+ * dimensions of the grid are not checked when it is loaded and have to be validated before adding the slice.
+ */
+void Detector::addElectricFieldSlice(double time,
+                                     const std::string& key,
+                                     std::function<std::shared_ptr<std::vector<double>>()> loader,
+                                     std::array<size_t, 3> dimensions,
+                                     std::array<double, 2> scales,
+                                     std::array<double, 2> offset,
+                                     std::pair<double, double> thickness_domain) {
+    // Copy the static field to inherit the model parameters of this detector
+    auto field = electric_field_;
+    FieldSliceLoader<ROOT::Math::XYZVector, 3> slice_loader =
+        [field, loader, dimensions, scales, offset, thickness_domain]() mutable {
+            field.setGrid(loader(), dimensions, scales, offset, thickness_domain);
+            return field;
+        };
+    transient_electric_field_.addSlice(time, key, std::move(slice_loader));
+}
+
 void Detector::setElectricFieldFunction(FieldFunction<ROOT::Math::XYZVector> function,
                                         std::pair<double, double> thickness_domain,
                                         FieldType type) {
@@ -231,6 +286,23 @@ double Detector::getWeightingPotential(const ROOT::Math::XYZPoint& pos, const Pi
     return weighting_potential_.getRelativeTo(pos, {local_x, local_y}, true);
 }
 
+/**
+ * All reference pixels are evaluated in a single query of the weighting potential, which resolves the position along z only
+ * once for the full pixel matrix.
+ */
+std::vector<double> Detector::getWeightingPotential(const ROOT::Math::XYZPoint& pos,
+                                                    const std::vector<Pixel::Index>& references) const {
+    auto size = model_->getPixelSize();
+
+    // WARNING This relies on the origin of the local coordinate system
+    std::vector<ROOT::Math::XYPoint> reference_positions;
+    reference_positions.reserve(references.size());
+    for(const auto& reference : references) {
+        reference_positions.emplace_back(size.x() * reference.x(), size.y() * reference.y());
+    }
+    return weighting_potential_.getRelativeTo(pos, reference_positions, true);
+}
+
 /**
  * The type of the weighting potential is set depending on the function used to apply it.
  */
@@ -260,16 +332,63 @@ bool Detector::hasMagneticField() const {
     return magnetic_field_on_;
 }
 
-// TODO Currently the magnetic field in the detector is fixed to the field vector at it's center position. Change in case a
-// field gradient is needed inside the sensor.
 void Detector::setMagneticField(ROOT::Math::XYZVector b_field) {
     magnetic_field_on_ = true;
     magnetic_field_ = std::move(b_field);
+    magnetic_field_grid_.reset();
+}
+
+/**
+ * @throws std::invalid_argument If the grid is empty or its size does not match the dimensions
+ *
+ * The grid points span the full sensor, the first and last point along each axis are located at the sensor edges. Axes
+ * with a single grid point are sampled at the sensor center and the field is taken as constant along them.
+ */
+void Detector::setMagneticFieldGrid(ROOT::Math::XYZVector b_field,
+                                    std::shared_ptr<std::vector<double>> field,
+                                    std::array<size_t, 3> dimensions) {
+    if(dimensions[0] == 0 || dimensions[1] == 0 || dimensions[2] == 0) {
+        throw std::invalid_argument("magnetic field grid dimensions should be larger than zero");
+    }
+    if(field == nullptr || field->size() != dimensions[0] * dimensions[1] * dimensions[2] * 3) {
+        throw std::invalid_argument("magnetic field grid does not match the given dimensions");
+    }
+
+    auto sensor_center = model_->getSensorCenter();
+    auto sensor_size = model_->getSensorSize();
+    std::array<double, 3> size{{sensor_size.x(), sensor_size.y(), sensor_size.z()}};
+    for(size_t i = 0; i < 3; ++i) {
+        magnetic_field_spacing_[i] = (dimensions[i] > 1 ? size[i] / static_cast<double>(dimensions[i] - 1) : 0);
+    }
+    magnetic_field_origin_ = sensor_center - sensor_size / 2.0;
+
+    magnetic_field_on_ = true;
+    magnetic_field_ = std::move(b_field);
+    magnetic_field_grid_ = std::move(field);
+    magnetic_field_dimensions_ = dimensions;
 }
 
 /**
- * The magnetic field is evaluated for any sensor position.
+ * The magnetic field at the center of the sensor, used as approximation if a constant field is sufficient.
  */
 ROOT::Math::XYZVector Detector::getMagneticField() const {
     return magnetic_field_;
 }
+
+/**
+ * The magnetic field is interpolated from the grid cached for the sensor, outside of the sensor the value at the closest
+ * grid point is used. Without a grid, the constant field is returned.
+ */
+ROOT::Math::XYZVector Detector::getMagneticField(const ROOT::Math::XYZPoint& pos) const {
+    if(magnetic_field_grid_ == nullptr) {
+        return magnetic_field_;
+    }
+
+    std::array<double, 3> index{};
+    auto dist = pos - magnetic_field_origin_;
+    std::array<double, 3> coordinates{{dist.x(), dist.y(), dist.z()}};
+    for(size_t i = 0; i < 3; ++i) {
+        index[i] = (magnetic_field_dimensions_[i] > 1 ? coordinates[i] / magnetic_field_spacing_[i] : 0);
+    }
+    return interpolate_vector_field(*magnetic_field_grid_, magnetic_field_dimensions_, index);
+}
@@ -142,6 +142,23 @@ namespace allpix {
          * @return Vector of the field at the queried point
          */
         ROOT::Math::XYZVector getElectricField(const ROOT::Math::XYZPoint& local_pos) const;
+        /**
+         * @brief Get the electric field in the sensor at a local position and time
+         * @param local_pos Position in the local frame
+         * @param time Time of the query, relative to the start of the event
+         * @return Vector of the field at the queried point and time, the static field is used if no time slices are set
+         */
+        ROOT::Math::XYZVector getElectricField(const ROOT::Math::XYZPoint& local_pos, double time) const;
+        /**
+         * @brief Returns if the detector has a time-dependent electric field in the sensor
+         * @return True if time slices of the electric field are set, false otherwise
+         */
+        bool hasTransientElectricField() const;
+        /**
+         * @brief Get the time-dependent electric field of the detector
+         * @return Reference to the time-sliced electric field
+         */
+        const TimeSlicedField<ROOT::Math::XYZVector, 3>& getTransientElectricField() const;
 
         /**
          * @brief Set the electric field in a single pixel in the detector using a grid
@@ -155,6 +172,23 @@ namespace allpix {
                                   std::array<double, 2> scales,
                                   std::array<double, 2> offset,
                                   std::pair<double, double> thickness_domain);
+        /**
+         * @brief Add a time slice of the electric field in a single pixel using a grid which is loaded on first use
+         * @param time Time at which the slice is defined, relative to the start of the event
+         * @param key Identifier of the field grid, slices with the same key share the grid
+         * @param loader Function returning the flat array of the field vectors of the slice
+         * @param sizes The dimensions of the flat electric field array
+         * @param scales Scaling factors for the field size, given in fractions of a pixel unit cell in x and y
+         * @param offset Offset of the field in x and y, given in physical units
+         * @param thickness_domain Domain in local coordinates in the thickness direction where the field holds
+         */
+        void addElectricFieldSlice(double time,
+                                   const std::string& key,
+                                   std::function<std::shared_ptr<std::vector<double>>()> loader,
+                                   std::array<size_t, 3> sizes,
+                                   std::array<double, 2> scales,
+                                   std::array<double, 2> offset,
+                                   std::pair<double, double> thickness_domain);
         /**
          * @brief Set the electric field in a single pixel using a function
          * @param function Function used to retrieve the electric field
@@ -184,6 +218,14 @@ namespace allpix {
          * @return Value of the potential at the queried point
          */
         double getWeightingPotential(const ROOT::Math::XYZPoint& local_pos, const Pixel::Index& reference) const;
+        /**
+         * @brief Get the weighting potential at a local position for a set of reference pixels in a single query
+         * @param local_pos Position in the local frame
+         * @param references Indices of the pixels for which the weighting potential is requested
+         * @return Values of the potential at the queried point, in the order of the reference pixels
+         */
+        std::vector<double> getWeightingPotential(const ROOT::Math::XYZPoint& local_pos,
+                                                  const std::vector<Pixel::Index>& references) const;
 
         /**
          * @brief Set the weighting potential in a single pixel in the detector using a grid
@@ -208,22 +250,36 @@ namespace allpix {
 
         /**
          * @brief Set the magnetic field in the detector
-         * @param function Function used to retrieve the magnetic field
-         * @param type Type of the magnetic field function used
+         * @param b_field Constant magnetic field vector in the local frame
          */
         void setMagneticField(ROOT::Math::XYZVector b_field);
+        /**
+         * @brief Set a position-dependent magnetic field in the detector using a grid spanning the sensor
+         * @param b_field Constant magnetic field vector in the local frame at the center of the sensor
+         * @param field Flat array of the field vectors in the local frame, sampled at equidistant points from one sensor
+         * edge to the opposite one
+         * @param dimensions Number of grid points in x, y and z
+         */
+        void setMagneticFieldGrid(ROOT::Math::XYZVector b_field,
+                                  std::shared_ptr<std::vector<double>> field,
+                                  std::array<size_t, 3> dimensions);
 
         /**
          * @brief Returns if the detector has a magnetic field in the sensor
          * @return True if the detector has an magnetic field, false otherwise
          */
         bool hasMagneticField() const;
+        /**
+         * @brief Get the magnetic field at the center of the sensor
+         * @return Vector of the field at the center of the sensor
+         */
+        ROOT::Math::XYZVector getMagneticField() const;
         /**
          * @brief Get the magnetic field in the sensor at a local position
-         * @param pos Position in the local frame
+         * @param local_pos Position in the local frame
          * @return Vector of the field at the queried point
          */
-        ROOT::Math::XYZVector getMagneticField() const;
+        ROOT::Math::XYZVector getMagneticField(const ROOT::Math::XYZPoint& local_pos) const;
 
         /**
          * @brief Get the model of this detector
@@ -247,21 +303,51 @@ namespace allpix {
         void set_model(std::shared_ptr<DetectorModel> model);
 
         /**
-         * @brief Create the coordinate transformation
+         * @brief Create the coordinate transformations and the cache of the geometry derived from the model
          */
         void build_transform();
 
+        /**
+         * @brief Geometry derived from the detector model, cached for the queries in the hot path
+         *
+         * The values are computed once when the model is attached, which happens at the latest when the geometry is closed,
+         * such that the frequent position queries do not call the virtual getters of the model. The values are stored
+         * contiguously, as they are read together for every step of the charge carrier transport.
+         */
+        struct GeometryCache {
+            // Center and half size of the sensor box in local coordinates
+            ROOT::Math::XYZPoint sensor_center;
+            ROOT::Math::XYZVector sensor_half_size;
+            // Pixel pitch and its reciprocal
+            ROOT::Math::XYVector pixel_size;
+            double inverse_pixel_size_x{};
+            double inverse_pixel_size_y{};
+            // Half size of the pixel implant
+            double implant_half_size_x{};
+            double implant_half_size_y{};
+            // Local z-coordinate of the pixel centers
+            double pixel_z{};
+            // Number of pixels in both directions
+            unsigned int n_pixels_x{};
+            unsigned int n_pixels_y{};
+        };
+
         std::string name_;
         std::shared_ptr<DetectorModel> model_;
 
         ROOT::Math::XYZPoint position_;
         ROOT::Math::Rotation3D orientation_;
 
-        // Transform matrix from global to local coordinates
+        // Transform matrices from local to global coordinates and back
         ROOT::Math::Transform3D transform_;
+        ROOT::Math::Transform3D inverse_transform_;
+
+        // Cached geometry of the model
+        GeometryCache geometry_;
 
         // Electric field
         DetectorField<ROOT::Math::XYZVector, 3> electric_field_;
+        TimeSlicedField<ROOT::Math::XYZVector, 3> transient_electric_field_;
 
         // Weighting potential
         DetectorField<double, 1> weighting_potential_;
@@ -269,6 +355,12 @@ namespace allpix {
         // Magnetic field properties
         ROOT::Math::XYZVector magnetic_field_;
         bool magnetic_field_on_;
+
+        // Grid of the magnetic field in the local frame, empty for a constant field
+        std::shared_ptr<std::vector<double>> magnetic_field_grid_;
+        std::array<size_t, 3> magnetic_field_dimensions_{};
+        ROOT::Math::XYZPoint magnetic_field_origin_;
+        std::array<double, 3> magnetic_field_spacing_{};
     };
 
 } // namespace allpix
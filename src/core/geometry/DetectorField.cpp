@@ -10,6 +10,8 @@
 
 #include "DetectorField.hpp"
 
+#include <algorithm>
+
 namespace allpix {
 
     /*
@@ -29,4 +31,46 @@ namespace allpix {
      * Here, no inversion of the field components is required
      */
     template <> void flip_vector_components<double>(double&, bool, bool) {}
+
+    /*
+     * The eight grid points surrounding the fractional index are weighted by their distance along each axis. Axes with a
+     * single grid point are treated as constant.
+     */
+    ROOT::Math::XYZVector interpolate_vector_field(const std::vector<double>& field,
+                                                   std::array<size_t, 3> dimensions,
+                                                   std::array<double, 3> index) {
+        std::array<size_t, 3> low{};
+        std::array<double, 3> frac{};
+        for(size_t i = 0; i < 3; ++i) {
+            auto max = static_cast<double>(dimensions[i] - 1);
+            // TODO When moving to C++17, this can be replaced with std::clamp()
+            auto pos = std::max(0.0, std::min(index[i], max));
+            low[i] = std::min(static_cast<size_t>(pos), dimensions[i] > 1 ? dimensions[i] - 2 : 0);
+            frac[i] = (dimensions[i] > 1 ? pos - static_cast<double>(low[i]) : 0.0);
+        }
+
+        std::array<double, 3> value{};
+        for(size_t corner = 0; corner < 8; ++corner) {
+            std::array<size_t, 3> ind{};
+            double weight = 1.0;
+            for(size_t i = 0; i < 3; ++i) {
+                bool high = ((corner >> i) & 1u) != 0;
+                if(high && dimensions[i] == 1) {
+                    weight = 0.0;
+                    break;
+                }
+                ind[i] = low[i] + (high ? 1 : 0);
+                weight *= (high ? frac[i] : 1.0 - frac[i]);
+            }
+            if(weight == 0.0) {
+                continue;
+            }
+
+            auto tot_ind = (ind[0] * dimensions[1] * dimensions[2] + ind[1] * dimensions[2] + ind[2]) * 3;
+            for(size_t c = 0; c < 3; ++c) {
+                value[c] += weight * field[tot_ind + c];
+            }
+        }
+        return {value[0], value[1], value[2]};
+    }
 } // namespace allpix
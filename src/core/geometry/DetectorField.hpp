@@ -11,8 +11,14 @@
 #ifndef ALLPIX_DETECTOR_FIELD_H
 #define ALLPIX_DETECTOR_FIELD_H
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include <Math/Point2D.h>
@@ -50,6 +56,17 @@ namespace allpix {
      */
     template <typename T> void flip_vector_components(T& field, bool x, bool y);
 
+    /**
+     * @brief Helper function to trilinearly interpolate a vector field sampled on a regular grid
+     * @param field      Flat array of the field with three components per grid point
+     * @param dimensions Number of grid points in x, y and z
+     * @param index      Fractional grid index of the queried position in x, y and z, clamped to the grid
+     * @return Interpolated field vector
+     */
+    ROOT::Math::XYZVector interpolate_vector_field(const std::vector<double>& field,
+                                                   std::array<size_t, 3> dimensions,
+                                                   std::array<double, 3> index);
+
     /**
      * @brief Field instance of a detector
      *
@@ -95,6 +112,19 @@ namespace allpix {
                         const ROOT::Math::XYPoint& reference,
                         const bool extrapolate_z = false) const;
 
+        /**
+         * @brief Get the values of the field at a position provided in local coordinates with respect to a set of references
+         * @param pos        Position in the local frame
+         * @param references Reference positions to calculate the field for, x and y coordinate only
+         * @param extrapolate_z Extrapolate the field along z when outside the defined region
+         * @return Value(s) of the field assigned to each of the reference pixels at the queried point
+         *
+         * Equivalent to calling \ref getRelativeTo for every reference, but the position along z is only resolved once.
+         */
+        std::vector<T> getRelativeTo(const ROOT::Math::XYZPoint& local_pos,
+                                     const std::vector<ROOT::Math::XYPoint>& references,
+                                     const bool extrapolate_z = false) const;
+
         /**
          * @brief Set the field in the detector using a grid
          * @param field Flat array of the field
@@ -184,6 +214,87 @@ namespace allpix {
         ROOT::Math::XYZVector sensor_size_{};
         bool model_initialized_{};
     };
+
+    /**
+     * @brief Functor returning a detector field for a single time slice, called when the slice is used for the first time
+     */
+    template <typename T, size_t N = 3> using FieldSliceLoader = std::function<DetectorField<T, N>()>;
+
+    /**
+     * @brief Time-dependent field of a detector, defined by a sequence of fields at fixed points in time
+     *
+     * The field at a given time is linearly interpolated between the two adjacent time slices, before the first and after
+     * the last slice the field of the respective slice is used. Slices are identified by a key, slices with the same key
+     * share a single field instance. This allows to store fields which only change during some periods of time compactly,
+     * and the interpolation is skipped between slices sharing the same field.
+     *
+     * The field of a slice is only loaded when it is requested for the first time. Loading is thread-safe, such that the
+     * field can be queried from several threads concurrently.
+     */
+    template <typename T, size_t N = 3> class TimeSlicedField {
+    public:
+        /**
+         * @brief Constructs an empty time-sliced field
+         */
+        TimeSlicedField() = default;
+
+        /**
+         * @brief Check if at least one time slice is configured
+         * @return Boolean indicating field validity
+         */
+        bool isValid() const { return !times_.empty(); }
+
+        /**
+         * @brief Get the field value in the sensor at a position provided in local coordinates at a given time
+         * @param local_pos Position in the local frame
+         * @param time Time of the query
+         * @return Value(s) of the field at the queried point and time
+         */
+        T get(const ROOT::Math::XYZPoint& local_pos, double time) const;
+
+        /**
+         * @brief Add a time slice of the field
+         * @param time Time at which the slice is defined, has to be after the time of all previous slices
+         * @param key Identifier of the field of the slice, slices with the same key share a field
+         * @param loader Function returning the field of the slice, only called for the first slice with a given key
+         */
+        void addSlice(double time, const std::string& key, FieldSliceLoader<T, N> loader);
+
+        /**
+         * @brief Get the number of time slices
+         * @return Number of time slices
+         */
+        size_t getSlices() const { return times_.size(); }
+
+        /**
+         * @brief Get the number of distinct fields which have been loaded so far
+         * @return Number of loaded fields
+         */
+        size_t getLoadedFields() const { return loaded_fields_; }
+
+    private:
+        /**
+         * @brief Distinct field shared between all slices with the same key, loaded on first access
+         */
+        struct SharedField {
+            FieldSliceLoader<T, N> loader;
+            std::once_flag loaded;
+            DetectorField<T, N> field;
+        };
+
+        /**
+         * @brief Helper function to retrieve a field, loading it if necessary
+         * @param index Index of the distinct field
+         * @return Reference to the loaded field
+         */
+        const DetectorField<T, N>& get_field(size_t index) const;
+
+        std::vector<double> times_;
+        std::vector<size_t> slice_fields_;
+        std::vector<std::unique_ptr<SharedField>> fields_;
+        std::map<std::string, size_t> field_keys_;
+        mutable std::atomic<size_t> loaded_fields_{0};
+    };
 } // namespace allpix
 
 // Include template members
@@ -46,6 +46,66 @@ namespace allpix {
         return ret_val;
     }
 
+    /**
+     * The index along z of the grid or the clamped z coordinate for field functions only depends on the queried position and
+     * is therefore shared by all references, only the in-plane index is computed for every reference.
+     */
+    template <typename T, size_t N>
+    std::vector<T> DetectorField<T, N>::getRelativeTo(const ROOT::Math::XYZPoint& pos,
+                                                      const std::vector<ROOT::Math::XYPoint>& references,
+                                                      const bool extrapolate_z) const {
+        std::vector<T> values(references.size());
+        if(type_ == FieldType::NONE) {
+            return values;
+        }
+
+        auto z = pos.z();
+        if(type_ == FieldType::GRID) {
+            auto z_ind = static_cast<int>(std::floor(static_cast<double>(dimensions_[2]) * (z - thickness_domain_.first) /
+                                                     (thickness_domain_.second - thickness_domain_.first)));
+            if(extrapolate_z) {
+                z_ind = std::max(0, std::min(z_ind, static_cast<int>(dimensions_[2]) - 1));
+            } else if(z_ind < 0 || z_ind >= static_cast<int>(dimensions_[2])) {
+                return values;
+            }
+            auto z_offset = static_cast<size_t>(z_ind) * N;
+
+            for(size_t i = 0; i < references.size(); ++i) {
+                auto x = pos.x() - references[i].x();
+                auto y = pos.y() - references[i].y();
+
+                // clang-format off
+                auto x_ind = (dimensions_[0] == 1 ? 0
+                                                  : static_cast<int>(std::floor(static_cast<double>(dimensions_[0]) *
+                                                                                (x + scales_[0] / 2.0) / scales_[0])));
+                auto y_ind = (dimensions_[1] == 1 ? 0
+                                                  : static_cast<int>(std::floor(static_cast<double>(dimensions_[1]) *
+                                                                                (y + scales_[1] / 2.0) / scales_[1])));
+                // clang-format on
+                if(x_ind < 0 || x_ind >= static_cast<int>(dimensions_[0]) || y_ind < 0 ||
+                   y_ind >= static_cast<int>(dimensions_[1])) {
+                    continue;
+                }
+
+                size_t tot_ind = static_cast<size_t>(x_ind) * dimensions_[1] * dimensions_[2] * N +
+                                 static_cast<size_t>(y_ind) * dimensions_[2] * N + z_offset;
+                values[i] = get_impl(tot_ind, std::make_index_sequence<N>{});
+            }
+        } else {
+            if(extrapolate_z) {
+                z = std::max(thickness_domain_.first, std::min(z, thickness_domain_.second));
+            } else if(z < thickness_domain_.first || thickness_domain_.second < z) {
+                return values;
+            }
+
+            for(size_t i = 0; i < references.size(); ++i) {
+                values[i] = function_(ROOT::Math::XYZPoint(pos.x() - references[i].x(), pos.y() - references[i].y(), z));
+            }
+        }
+
+        return values;
+    }
+
     // Maps the field indices onto the range of -d/2 < x < d/2, where d is the scale of the field in coordinate x.
     // This means, {x,y,z} = (0,0,0) is in the center of the field.
     template <typename T, size_t N>
@@ -191,4 +251,63 @@ namespace allpix {
         function_ = std::move(function);
         type_ = type;
     }
+
+    /**
+     * The slice preceding the requested time is found by a binary search over the slice times. If both adjacent slices share
+     * the same field, it is returned directly without interpolation.
+     */
+    template <typename T, size_t N>
+    T TimeSlicedField<T, N>::get(const ROOT::Math::XYZPoint& pos, double time) const {
+        if(times_.empty()) {
+            return {};
+        }
+        if(time <= times_.front()) {
+            return get_field(slice_fields_.front()).get(pos);
+        }
+        if(time >= times_.back()) {
+            return get_field(slice_fields_.back()).get(pos);
+        }
+
+        auto next = static_cast<size_t>(std::upper_bound(times_.begin(), times_.end(), time) - times_.begin());
+        auto prev = next - 1;
+        if(slice_fields_[prev] == slice_fields_[next]) {
+            return get_field(slice_fields_[prev]).get(pos);
+        }
+
+        // Linear interpolation between the adjacent slices
+        auto weight = (time - times_[prev]) / (times_[next] - times_[prev]);
+        return get_field(slice_fields_[prev]).get(pos) * (1 - weight) + get_field(slice_fields_[next]).get(pos) * weight;
+    }
+
+    /**
+     * @throws std::invalid_argument If the time of the slice is not after the time of the previous slice
+     */
+    template <typename T, size_t N>
+    void TimeSlicedField<T, N>::addSlice(double time, const std::string& key, FieldSliceLoader<T, N> loader) {
+        if(!times_.empty() && time <= times_.back()) {
+            throw std::invalid_argument("time slices have to be given in increasing order of time");
+        }
+
+        auto iter = field_keys_.find(key);
+        if(iter == field_keys_.end()) {
+            auto field = std::make_unique<SharedField>();
+            field->loader = std::move(loader);
+            fields_.push_back(std::move(field));
+            iter = field_keys_.emplace(key, fields_.size() - 1).first;
+        }
+
+        times_.push_back(time);
+        slice_fields_.push_back(iter->second);
+    }
+
+    template <typename T, size_t N> const DetectorField<T, N>& TimeSlicedField<T, N>::get_field(size_t index) const {
+        auto& shared_field = *fields_[index];
+        std::call_once(shared_field.loaded, [&]() {
+            shared_field.field = shared_field.loader();
+            // Release the loader and all data it might hold
+            shared_field.loader = nullptr;
+            loaded_fields_++;
+        });
+        return shared_field.field;
+    }
 } // namespace allpix
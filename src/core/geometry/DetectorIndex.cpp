@@ -0,0 +1,244 @@
+/**
+ * @file
+ * @brief Implementation of the spatial index of the detectors
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "DetectorIndex.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace allpix;
+
+namespace {
+    // Maximum number of detectors stored in a single leaf of the tree
+    constexpr size_t max_leaf_size = 2;
+
+    template <typename T> std::array<double, 3> to_array(const T& vec) { return {{vec.x(), vec.y(), vec.z()}}; }
+} // namespace
+
+void DetectorIndex::build(const std::vector<std::shared_ptr<Detector>>& detectors) {
+    entries_.clear();
+    nodes_.clear();
+
+    entries_.reserve(detectors.size());
+    for(size_t i = 0; i < detectors.size(); ++i) {
+        auto model = detectors[i]->getModel();
+        auto center = model->getGeometricalCenter();
+        auto size = model->getSize();
+
+        Entry entry;
+        entry.detector = detectors[i];
+        entry.order = i;
+        entry.local_box.lower = to_array(center - size / 2.0);
+        entry.local_box.upper = to_array(center + size / 2.0);
+
+        // Bounding box of the eight corners of the rotated detector volume in the global frame
+        entry.global_box.lower.fill(std::numeric_limits<double>::max());
+        entry.global_box.upper.fill(std::numeric_limits<double>::lowest());
+        for(size_t corner = 0; corner < 8; ++corner) {
+            ROOT::Math::XYZPoint point((corner & 1u) != 0 ? entry.local_box.upper[0] : entry.local_box.lower[0],
+                                       (corner & 2u) != 0 ? entry.local_box.upper[1] : entry.local_box.lower[1],
+                                       (corner & 4u) != 0 ? entry.local_box.upper[2] : entry.local_box.lower[2]);
+            auto global = to_array(detectors[i]->getGlobalPosition(point));
+            for(size_t axis = 0; axis < 3; ++axis) {
+                entry.global_box.lower[axis] = std::min(entry.global_box.lower[axis], global[axis]);
+                entry.global_box.upper[axis] = std::max(entry.global_box.upper[axis], global[axis]);
+            }
+        }
+        entries_.push_back(std::move(entry));
+    }
+
+    if(!entries_.empty()) {
+        nodes_.reserve(2 * entries_.size());
+        build_node(0, entries_.size());
+    }
+}
+
+size_t DetectorIndex::build_node(size_t begin, size_t end) {
+    // Bounding box of all entries and of their centers
+    Node node;
+    Box centers;
+    node.box.lower.fill(std::numeric_limits<double>::max());
+    node.box.upper.fill(std::numeric_limits<double>::lowest());
+    centers = node.box;
+    for(size_t i = begin; i < end; ++i) {
+        const auto& box = entries_[i].global_box;
+        for(size_t axis = 0; axis < 3; ++axis) {
+            auto center = (box.lower[axis] + box.upper[axis]) / 2.0;
+            node.box.lower[axis] = std::min(node.box.lower[axis], box.lower[axis]);
+            node.box.upper[axis] = std::max(node.box.upper[axis], box.upper[axis]);
+            centers.lower[axis] = std::min(centers.lower[axis], center);
+            centers.upper[axis] = std::max(centers.upper[axis], center);
+        }
+    }
+
+    // Split along the axis with the largest spread of the detector centers
+    size_t split_axis = 0;
+    for(size_t axis = 1; axis < 3; ++axis) {
+        if(centers.upper[axis] - centers.lower[axis] > centers.upper[split_axis] - centers.lower[split_axis]) {
+            split_axis = axis;
+        }
+    }
+
+    auto index = nodes_.size();
+    nodes_.push_back(node);
+
+    // Store the entries in a leaf if there are only few of them or if they cannot be separated
+    if(end - begin <= max_leaf_size || centers.upper[split_axis] <= centers.lower[split_axis]) {
+        nodes_[index].leaf = true;
+        nodes_[index].first = begin;
+        nodes_[index].second = end;
+        return index;
+    }
+
+    auto middle = begin + (end - begin) / 2;
+    std::nth_element(entries_.begin() + static_cast<std::ptrdiff_t>(begin),
+                     entries_.begin() + static_cast<std::ptrdiff_t>(middle),
+                     entries_.begin() + static_cast<std::ptrdiff_t>(end),
+                     [split_axis](const Entry& lhs, const Entry& rhs) {
+                         return lhs.global_box.lower[split_axis] + lhs.global_box.upper[split_axis] <
+                                rhs.global_box.lower[split_axis] + rhs.global_box.upper[split_axis];
+                     });
+
+    // NOTE the children are added after the parent, references to the nodes are invalidated while building them
+    auto left = build_node(begin, middle);
+    auto right = build_node(middle, end);
+    nodes_[index].first = left;
+    nodes_[index].second = right;
+    return index;
+}
+
+std::vector<std::shared_ptr<Detector>> DetectorIndex::findContaining(const ROOT::Math::XYZPoint& position) const {
+    std::vector<std::shared_ptr<Detector>> result;
+    if(nodes_.empty()) {
+        return result;
+    }
+
+    auto point = to_array(position);
+    std::vector<const Entry*> found;
+    std::vector<size_t> stack{0};
+    while(!stack.empty()) {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+        if(!contains(node.box, point)) {
+            continue;
+        }
+        if(!node.leaf) {
+            stack.push_back(node.first);
+            stack.push_back(node.second);
+            continue;
+        }
+
+        for(size_t i = node.first; i < node.second; ++i) {
+            const auto& entry = entries_[i];
+            if(contains(entry.global_box, point) &&
+               contains(entry.local_box, to_array(entry.detector->getLocalPosition(position)))) {
+                found.push_back(&entry);
+            }
+        }
+    }
+
+    // Return the detectors in a deterministic order independent of the layout of the tree
+    std::sort(found.begin(), found.end(), [](const Entry* lhs, const Entry* rhs) { return lhs->order < rhs->order; });
+    result.reserve(found.size());
+    for(const auto* entry : found) {
+        result.push_back(entry->detector);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<Detector>> DetectorIndex::findIntersecting(const ROOT::Math::XYZPoint& origin,
+                                                                       const ROOT::Math::XYZVector& direction) const {
+    std::vector<std::shared_ptr<Detector>> result;
+    if(nodes_.empty()) {
+        return result;
+    }
+
+    auto global_origin = to_array(origin);
+    auto global_direction = to_array(direction);
+    std::vector<std::pair<double, const Entry*>> found;
+    std::vector<size_t> stack{0};
+    while(!stack.empty()) {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+        if(!intersect(node.box, global_origin, global_direction).first) {
+            continue;
+        }
+        if(!node.leaf) {
+            stack.push_back(node.first);
+            stack.push_back(node.second);
+            continue;
+        }
+
+        for(size_t i = node.first; i < node.second; ++i) {
+            const auto& entry = entries_[i];
+            if(!intersect(entry.global_box, global_origin, global_direction).first) {
+                continue;
+            }
+
+            // The transformation to the local frame preserves lengths, such that the distances of all detectors agree
+            auto local_origin = entry.detector->getLocalPosition(origin);
+            auto local_direction = entry.detector->getLocalPosition(origin + direction) - local_origin;
+            auto hit = intersect(entry.local_box, to_array(local_origin), to_array(local_direction));
+            if(hit.first) {
+                found.emplace_back(hit.second, &entry);
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second->order < rhs.second->order);
+    });
+    result.reserve(found.size());
+    for(const auto& hit : found) {
+        result.push_back(hit.second->detector);
+    }
+    return result;
+}
+
+bool DetectorIndex::contains(const Box& box, const std::array<double, 3>& point) {
+    for(size_t axis = 0; axis < 3; ++axis) {
+        if(point[axis] < box.lower[axis] || point[axis] > box.upper[axis]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * The ray is clipped against the pair of planes bounding the box along every axis (slab test). Components of the direction
+ * equal to zero are treated separately to avoid divisions by zero for rays parallel to the planes.
+ */
+std::pair<bool, double> DetectorIndex::intersect(const Box& box,
+                                                 const std::array<double, 3>& origin,
+                                                 const std::array<double, 3>& direction) {
+    double distance_min = 0;
+    double distance_max = std::numeric_limits<double>::max();
+    for(size_t axis = 0; axis < 3; ++axis) {
+        if(direction[axis] == 0) {
+            if(origin[axis] < box.lower[axis] || origin[axis] > box.upper[axis]) {
+                return {false, 0};
+            }
+            continue;
+        }
+
+        auto inverse = 1.0 / direction[axis];
+        auto distance_lower = (box.lower[axis] - origin[axis]) * inverse;
+        auto distance_upper = (box.upper[axis] - origin[axis]) * inverse;
+        if(distance_lower > distance_upper) {
+            std::swap(distance_lower, distance_upper);
+        }
+        distance_min = std::max(distance_min, distance_lower);
+        distance_max = std::min(distance_max, distance_upper);
+        if(distance_min > distance_max) {
+            return {false, 0};
+        }
+    }
+    return {true, distance_min};
+}
@@ -0,0 +1,108 @@
+/**
+ * @file
+ * @brief Spatial index of the detectors for lookups by global coordinates
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_DETECTOR_INDEX_H
+#define ALLPIX_DETECTOR_INDEX_H
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <Math/Point3D.h>
+#include <Math/Vector3D.h>
+
+#include "Detector.hpp"
+
+namespace allpix {
+
+    /**
+     * @brief Bounding volume hierarchy over the volumes of all detectors
+     *
+     * The index stores the axis-aligned bounding box of every detector in the global frame and arranges them in a binary
+     * tree, splitting the detectors at the median of their centers along the axis of largest extent. Lookups of the
+     * detectors containing a point or crossed by a ray only descend into the branches whose bounding box is hit, and
+     * thus scale logarithmically with the number of detectors. The candidates found are checked exactly against the
+     * volume of the detector model in the local frame of the detector, taking its rotation into account.
+     *
+     * The index is constant after it has been built and can be queried from multiple threads concurrently.
+     */
+    class DetectorIndex {
+    public:
+        /**
+         * @brief Build the index from a list of detectors
+         * @param detectors Detectors to index, all of them need to have a model assigned
+         * @note Replaces the detectors indexed before
+         */
+        void build(const std::vector<std::shared_ptr<Detector>>& detectors);
+
+        /**
+         * @brief Find all detectors whose volume contains a point
+         * @param position Point in the global frame
+         * @return List of detectors containing the point, in the order they have been added to the index
+         */
+        std::vector<std::shared_ptr<Detector>> findContaining(const ROOT::Math::XYZPoint& position) const;
+
+        /**
+         * @brief Find all detectors whose volume is crossed by a ray
+         * @param origin Starting point of the ray in the global frame
+         * @param direction Direction of the ray in the global frame, does not need to be normalized
+         * @return List of detectors crossed by the ray, ordered by the distance at which the ray enters their volume
+         * @note Detectors behind the origin are not returned, a detector containing the origin is entered at distance zero
+         */
+        std::vector<std::shared_ptr<Detector>> findIntersecting(const ROOT::Math::XYZPoint& origin,
+                                                                const ROOT::Math::XYZVector& direction) const;
+
+    private:
+        /**
+         * @brief Axis-aligned box given by its lower and upper corner
+         */
+        struct Box {
+            std::array<double, 3> lower{};
+            std::array<double, 3> upper{};
+        };
+
+        /**
+         * @brief Node of the tree, either with two children or with a range of detectors as leaf
+         */
+        struct Node {
+            Box box;
+            // Index of the children for inner nodes, range of entries for leafs
+            size_t first{};
+            size_t second{};
+            bool leaf{};
+        };
+
+        /**
+         * @brief Detector with its bounding box in the global frame and its volume in the local frame
+         */
+        struct Entry {
+            std::shared_ptr<Detector> detector;
+            Box global_box;
+            Box local_box;
+            size_t order{};
+        };
+
+        // Recursively build the node for the entries in the given range and return its index
+        size_t build_node(size_t begin, size_t end);
+
+        // Check if a point is inside a box (including its surface)
+        static bool contains(const Box& box, const std::array<double, 3>& point);
+
+        // Check if a ray intersects with a box, returns if it does and the distance at which the box is entered
+        static std::pair<bool, double>
+        intersect(const Box& box, const std::array<double, 3>& origin, const std::array<double, 3>& direction);
+
+        std::vector<Entry> entries_;
+        std::vector<Node> nodes_;
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_DETECTOR_INDEX_H */
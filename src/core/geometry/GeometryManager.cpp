@@ -8,8 +8,12 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <array>
 #include <fstream>
+#include <iomanip>
+#include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +28,7 @@
 #include "core/config/ConfigReader.hpp"
 #include "core/module/exceptions.h"
 #include "core/utils/file.h"
+#include "core/utils/hash.h"
 #include "core/utils/log.h"
 #include "core/utils/unit.h"
 #include "exceptions.h"
@@ -362,6 +367,62 @@ std::vector<std::shared_ptr<Detector>> GeometryManager::getDetectorsByType(const
     return result;
 }
 
+std::vector<std::shared_ptr<Detector>> GeometryManager::getDetectorsAt(const ROOT::Math::XYZPoint& position) {
+    if(!closed_) {
+        close_geometry();
+    }
+
+    return detector_index_.findContaining(position);
+}
+
+std::vector<std::shared_ptr<Detector>> GeometryManager::getDetectorsAlong(const ROOT::Math::XYZPoint& origin,
+                                                                          const ROOT::Math::XYZVector& direction) {
+    if(!closed_) {
+        close_geometry();
+    }
+
+    return detector_index_.findIntersecting(origin, direction);
+}
+
+/**
+ * The hash is calculated from the names, types, positions and orientations of all detectors, the configuration of their
+ * models and the configuration of all passive elements. Additional points added to the geometry are not included.
+ */
+std::string GeometryManager::getConfigurationHash() {
+    if(!closed_) {
+        close_geometry();
+    }
+
+    std::ostringstream description;
+    description << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for(auto& detector : detectors_) {
+        auto position = detector->getPosition();
+        std::array<double, 9> rotation{};
+        detector->getOrientation().GetComponents(rotation.begin(), rotation.end());
+
+        description << detector->getName() << ' ' << detector->getType() << ' ' << position.x() << ' ' << position.y()
+                    << ' ' << position.z();
+        for(auto& component : rotation) {
+            description << ' ' << component;
+        }
+        description << '\n';
+
+        for(auto& config : detector->getModel()->getConfigurations()) {
+            for(auto& key_value : config.getAll()) {
+                description << key_value.first << '=' << key_value.second << '\n';
+            }
+        }
+    }
+    for(auto& config : passive_elements_) {
+        description << config.getName() << '\n';
+        for(auto& key_value : config.getAll()) {
+            description << key_value.first << '=' << key_value.second << '\n';
+        }
+    }
+
+    return stable_hash(description.str());
+}
+
 std::list<Configuration>& GeometryManager::getPassiveElements() {
     return passive_elements_;
 }
@@ -498,6 +559,9 @@ void GeometryManager::close_geometry() {
         }
     }
 
+    // Index the detector volumes for lookups by global position, now that all detectors have their model
+    detector_index_.build(detectors_);
+
     closed_ = true;
     LOG(TRACE) << "Closed geometry";
 }
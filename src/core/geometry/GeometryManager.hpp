@@ -19,6 +19,7 @@
 #include <Math/Vector3D.h>
 
 #include "Detector.hpp"
+#include "DetectorIndex.hpp"
 #include "DetectorModel.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "core/config/ConfigReader.hpp"
@@ -31,6 +32,7 @@ namespace allpix {
     enum class MagneticFieldType {
         NONE = 0, ///< No magnetic field is simulated
         CONSTANT, ///< Constant magnetic field (mostly for testing)
+        GRID,     ///< Magnetic field supplied through a regularized grid
         CUSTOM,   ///< Custom magnetic field function
     };
 
@@ -189,6 +191,34 @@ namespace allpix {
          */
         std::vector<std::shared_ptr<Detector>> getDetectorsByType(const std::string& type);
 
+        /**
+         * @brief Get all detectors whose volume contains a point
+         * @param position Point in the global frame
+         * @returns List of detectors containing the point, empty if the point is outside of all detectors
+         * @note The lookup uses a spatial index of the detector volumes and scales logarithmically with the number of
+         *       detectors. The full volume of the detector model is considered, use \ref Detector::isWithinSensor to check
+         *       if the point is inside the sensor.
+         * @note Closes the geometry if it has not been closed yet
+         */
+        std::vector<std::shared_ptr<Detector>> getDetectorsAt(const ROOT::Math::XYZPoint& position);
+
+        /**
+         * @brief Get all detectors whose volume is crossed by a ray
+         * @param origin Starting point of the ray in the global frame
+         * @param direction Direction of the ray in the global frame
+         * @returns List of detectors crossed by the ray, ordered by the distance from the origin at which they are entered
+         * @note Closes the geometry if it has not been closed yet
+         */
+        std::vector<std::shared_ptr<Detector>> getDetectorsAlong(const ROOT::Math::XYZPoint& origin,
+                                                                 const ROOT::Math::XYZVector& direction);
+
+        /**
+         * @brief Get a hash identifying the configuration of the geometry
+         * @return Hash of the detectors with their placement and model configuration and of the passive elements
+         * @note Closes the geometry if it has not been closed yet
+         */
+        std::string getConfigurationHash();
+
         /**
          * @brief Set the magnetic field in the volume
          * @param function Function used to retrieve the magnetic field
@@ -279,6 +309,7 @@ namespace allpix {
         std::map<std::string, std::vector<std::pair<Configuration, Detector*>>> nonresolved_models_;
         std::vector<std::shared_ptr<Detector>> detectors_;
         std::set<std::string> detector_names_;
+        DetectorIndex detector_index_;
 
         std::list<Configuration> passive_elements_;
         std::map<std::string, std::pair<ROOT::Math::XYZPoint, ROOT::Math::Rotation3D>> passive_orientations_;
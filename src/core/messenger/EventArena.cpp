@@ -0,0 +1,111 @@
+/**
+ * @file
+ * @brief Implementation of the event-scoped memory arena
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "EventArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace allpix;
+
+EventArena::EventArena(size_t block_size, size_t max_retained)
+    : block_size_(block_size), max_retained_(max_retained), generation_(new Generation()) {}
+
+EventArena::~EventArena() {
+    release(generation_);
+}
+
+// Round an address up to the next multiple of the alignment
+static std::uintptr_t align_up(std::uintptr_t address, size_t alignment) {
+    return (address + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Every allocation is preceded by a pointer to the generation of its block, such that it can be released without knowing
+ * the arena. Continues in the next block if the current one is exhausted. A new block is only requested from the system if
+ * none of the remaining blocks is large enough, requests larger than the block size receive a dedicated block.
+ */
+void* EventArena::allocate(size_t bytes, size_t alignment) {
+    alignment = std::max(alignment, alignof(Generation*));
+    auto header = align_up(sizeof(Generation*), alignment);
+
+    char* data = nullptr;
+    auto& blocks = generation_->blocks;
+    while(current_block_ < blocks.size()) {
+        auto base = reinterpret_cast<std::uintptr_t>(blocks[current_block_].data.get());
+        auto aligned = align_up(base + offset_, alignment);
+        if(aligned + header + bytes <= base + blocks[current_block_].size) {
+            offset_ = aligned + header + bytes - base;
+            data = reinterpret_cast<char*>(aligned + header);
+            break;
+        }
+        ++current_block_;
+        offset_ = 0;
+    }
+
+    if(data == nullptr) {
+        // Request a new block large enough for the allocation including its header and alignment
+        size_t size = std::max(block_size_, header + bytes + alignment);
+        blocks.push_back({std::make_unique<char[]>(size), size});
+        current_block_ = blocks.size() - 1;
+
+        auto base = reinterpret_cast<std::uintptr_t>(blocks.back().data.get());
+        auto aligned = align_up(base, alignment);
+        offset_ = aligned + header + bytes - base;
+        data = reinterpret_cast<char*>(aligned + header);
+    }
+
+    generation_->references.fetch_add(1, std::memory_order_relaxed);
+    *reinterpret_cast<Generation**>(data - sizeof(Generation*)) = generation_;
+    return data;
+}
+
+void EventArena::deallocate(void* ptr) noexcept {
+    release(*reinterpret_cast<Generation**>(static_cast<char*>(ptr) - sizeof(Generation*)));
+}
+
+void EventArena::release(Generation* generation) noexcept {
+    if(generation->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete generation;
+    }
+}
+
+/**
+ * Memory is never handed out twice while still in use: if any allocation outlives the event, the blocks stay with these
+ * allocations and are freed once the last of them is released. Otherwise the blocks are rewound, and blocks exceeding the
+ * retained size (for example dedicated blocks of large allocations) are returned to the system.
+ */
+bool EventArena::reset() {
+    current_block_ = 0;
+    offset_ = 0;
+
+    if(generation_->references.load(std::memory_order_acquire) != 1) {
+        release(generation_);
+        generation_ = new Generation();
+        return false;
+    }
+
+    auto& blocks = generation_->blocks;
+    size_t retained = 0;
+    auto last = std::find_if(blocks.begin(), blocks.end(), [&](const Block& block) {
+        retained += block.size;
+        return retained > max_retained_;
+    });
+    blocks.erase(last, blocks.end());
+    return true;
+}
+
+size_t EventArena::getCapacity() const {
+    size_t capacity = 0;
+    for(auto& block : generation_->blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
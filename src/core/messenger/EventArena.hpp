@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Event-scoped memory arena for message allocations
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_EVENT_ARENA_H
+#define ALLPIX_EVENT_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace allpix {
+    /**
+     * @brief Monotonic memory arena which is rewound at the end of every event
+     *
+     * Allocations are served by bumping an offset in large blocks. An arena is owned by a single thread: only this thread
+     * allocates from it, while allocations can be released from any thread without locking. The blocks belong to a
+     * generation which counts the allocations still in use. When the arena is \ref EventArena::reset "reset" and all
+     * allocations have been released, the blocks are rewound in a single operation and reused for the next event. If some
+     * allocations outlive the event, their generation is detached from the arena and freed by the last release, while the
+     * arena continues with new blocks.
+     */
+    class EventArena {
+    public:
+        /**
+         * @brief Construct the arena
+         * @param block_size Size in bytes of the blocks requested from the system
+         * @param max_retained Maximum size in bytes of the blocks kept for the next event when the arena is rewound
+         */
+        explicit EventArena(size_t block_size = 1 << 20, size_t max_retained = 1 << 23);
+
+        /**
+         * @brief Release the blocks of the arena, or leave them to allocations which are still in use
+         */
+        ~EventArena();
+
+        /// @{
+        /**
+         * @brief Copying or moving the arena is not allowed
+         */
+        EventArena(const EventArena&) = delete;
+        EventArena& operator=(const EventArena&) = delete;
+        EventArena(EventArena&&) = delete;
+        EventArena& operator=(EventArena&&) = delete;
+        /// @}
+
+        /**
+         * @brief Allocate memory from the arena
+         * @param bytes Number of bytes to allocate
+         * @param alignment Required alignment of the memory
+         * @return Pointer to the allocated memory
+         * @warning Should only be called by the thread owning the arena
+         */
+        void* allocate(size_t bytes, size_t alignment);
+
+        /**
+         * @brief Release memory allocated from any arena
+         * @param ptr Pointer to the memory
+         * @note The memory is only reused after the arena is reset, this can be called from any thread
+         */
+        static void deallocate(void* ptr) noexcept;
+
+        /**
+         * @brief Rewind the arena for the next event
+         * @return True if the blocks were rewound, false if allocations are still in use and new blocks are started
+         * @warning Should not be called while the owning thread allocates
+         */
+        bool reset();
+
+        /**
+         * @brief Get the total size of the blocks held by the current generation of the arena
+         * @return Capacity in bytes
+         */
+        size_t getCapacity() const;
+
+    private:
+        struct Block {
+            std::unique_ptr<char[]> data;
+            size_t size;
+        };
+        struct Generation {
+            std::vector<Block> blocks;
+            // Number of allocations in use plus one while the generation is owned by the arena
+            std::atomic<size_t> references{1};
+        };
+
+        /**
+         * @brief Release a reference to a generation and free it when it was the last one
+         * @param generation Generation to release
+         */
+        static void release(Generation* generation) noexcept;
+
+        size_t block_size_;
+        size_t max_retained_;
+        Generation* generation_;
+        size_t current_block_{0};
+        size_t offset_{0};
+    };
+
+    /**
+     * @brief Standard allocator drawing its memory from an \ref EventArena
+     *
+     * A default constructed allocator is not bound to any arena and uses the global heap instead. Containers using this
+     * allocator can thus also be filled outside of an event, for example to be kept across several events.
+     */
+    template <typename T> class ArenaAllocator {
+        template <typename U> friend class ArenaAllocator;
+
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        /**
+         * @brief Construct an allocator using the global heap
+         */
+        ArenaAllocator() noexcept = default;
+        /**
+         * @brief Construct an allocator for an arena
+         * @param arena Arena to allocate from
+         */
+        explicit ArenaAllocator(EventArena* arena) noexcept : arena_(arena) {}
+        /**
+         * @brief Rebind an allocator of another type to the same arena
+         */
+        template <typename U> explicit ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+        T* allocate(size_t n) {
+            if(arena_ == nullptr) {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(T* ptr, size_t) noexcept {
+            if(arena_ == nullptr) {
+                ::operator delete(ptr);
+            } else {
+                EventArena::deallocate(ptr);
+            }
+        }
+
+        template <typename U> bool operator==(const ArenaAllocator<U>& other) const noexcept {
+            return arena_ == other.arena_;
+        }
+        template <typename U> bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+            return arena_ != other.arena_;
+        }
+
+    private:
+        EventArena* arena_{nullptr};
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_EVENT_ARENA_H */
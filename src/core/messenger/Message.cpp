@@ -34,3 +34,7 @@ std::shared_ptr<const Detector> BaseMessage::getDetector() const {
 std::vector<std::reference_wrapper<Object>> BaseMessage::getObjectArray() {
     throw MessageWithoutObjectException(typeid(*this));
 }
+
+size_t BaseMessage::getMemorySize() const {
+    return sizeof(BaseMessage);
+}
@@ -11,8 +11,10 @@
 #ifndef ALLPIX_MESSAGE_H
 #define ALLPIX_MESSAGE_H
 
+#include <iterator>
 #include <vector>
 
+#include "EventArena.hpp"
 #include "core/geometry/Detector.hpp"
 #include "objects/Object.hpp"
 
@@ -53,6 +55,12 @@ namespace allpix {
          */
         virtual std::vector<std::reference_wrapper<Object>> getObjectArray();
 
+        /**
+         * @brief Get the approximate size of this message in memory
+         * @return Size of the message in bytes
+         */
+        virtual size_t getMemorySize() const;
+
     protected:
         /**
          * @brief Construct a general message not linked to a detector
@@ -68,6 +76,11 @@ namespace allpix {
         std::shared_ptr<const Detector> detector_;
     };
 
+    /**
+     * @brief List of objects stored in a message, allocated from an \ref EventArena if created by the \ref Messenger
+     */
+    template <typename T> using MessageData = std::vector<T, ArenaAllocator<T>>;
+
     /**
      * @brief Generic class for all messages
      *
@@ -78,19 +91,32 @@ namespace allpix {
         /**
          * @brief Constructs a message containing the supplied data
          * @param data List of data objects
+         * @warning The objects are moved to the storage of the message, references to them should only be set afterwards
          */
         explicit Message(std::vector<T> data);
         /**
          * @brief Constructs a message bound to a detector containing the supplied data
          * @param data List of data objects
          * @param detector Linked detector
+         * @warning The objects are moved to the storage of the message, references to them should only be set afterwards
          */
         Message(std::vector<T> data, const std::shared_ptr<const Detector>& detector);
+        /**
+         * @brief Constructs a message containing the supplied data without copying its storage
+         * @param data List of data objects, preferably created by \ref Messenger::createMessageData
+         */
+        explicit Message(MessageData<T> data);
+        /**
+         * @brief Constructs a message bound to a detector containing the supplied data without copying its storage
+         * @param data List of data objects, preferably created by \ref Messenger::createMessageData
+         * @param detector Linked detector
+         */
+        Message(MessageData<T> data, const std::shared_ptr<const Detector>& detector);
 
         /**
          * @brief Get a reference to the data in this message
          */
-        const std::vector<T>& getData() const;
+        const MessageData<T>& getData() const;
 
         /**
          * @brief Get data as list of objects if the contents can be converted
@@ -98,6 +124,12 @@ namespace allpix {
          */
         std::vector<std::reference_wrapper<Object>> getObjectArray() override;
 
+        /**
+         * @brief Get the approximate size of this message in memory
+         * @return Size of the message and its data in bytes
+         */
+        size_t getMemorySize() const override;
+
     private:
         /**
          * @brief Returns object array for messages containing objects
@@ -113,7 +145,7 @@ namespace allpix {
         std::vector<std::reference_wrapper<Object>>
         get_object_array(typename std::enable_if<!std::is_base_of<Object, U>::value>::type* = nullptr);
 
-        std::vector<T> data_;
+        MessageData<T> data_;
     };
 } // namespace allpix
 
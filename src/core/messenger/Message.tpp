@@ -11,12 +11,29 @@
 #include "exceptions.h"
 
 namespace allpix {
-    template <typename T> Message<T>::Message(std::vector<T> data) : BaseMessage(), data_(std::move(data)) {}
+    /**
+     * The objects are moved into storage allocated from the heap
+     */
+    template <typename T>
+    Message<T>::Message(std::vector<T> data)
+        : BaseMessage(), data_(std::make_move_iterator(data.begin()), std::make_move_iterator(data.end())) {}
+    /**
+     * The objects are moved into storage allocated from the heap
+     */
     template <typename T>
     Message<T>::Message(std::vector<T> data, const std::shared_ptr<const Detector>& detector)
+        : BaseMessage(detector), data_(std::make_move_iterator(data.begin()), std::make_move_iterator(data.end())) {}
+    template <typename T> Message<T>::Message(MessageData<T> data) : BaseMessage(), data_(std::move(data)) {}
+    template <typename T>
+    Message<T>::Message(MessageData<T> data, const std::shared_ptr<const Detector>& detector)
         : BaseMessage(detector), data_(std::move(data)) {}
 
-    template <typename T> const std::vector<T>& Message<T>::getData() const { return data_; }
+    template <typename T> const MessageData<T>& Message<T>::getData() const { return data_; }
+
+    /**
+     * Memory allocated by the stored objects themselves, e.g. for the pulse of a \ref PixelCharge, is not included.
+     */
+    template <typename T> size_t Message<T>::getMemorySize() const { return sizeof(*this) + data_.capacity() * sizeof(T); }
 
     /**
      * Chooses between internal \ref get_object_array implementations dependent on the type of the object (if it drives from
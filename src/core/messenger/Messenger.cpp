@@ -10,6 +10,7 @@
 
 #include "Messenger.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -17,13 +18,17 @@
 
 #include "Message.hpp"
 #include "core/module/Module.hpp"
+#include "core/module/exceptions.h"
 #include "core/utils/log.h"
 #include "core/utils/type.h"
 #include "delegates.h"
 
 using namespace allpix;
 
-Messenger::Messenger() = default;
+// Distinguishes the thread arenas of different messengers, addresses could be reused after a messenger is destroyed
+static std::atomic<unsigned int> messenger_count{0};
+
+Messenger::Messenger() : arena_id_(messenger_count++) {}
 #ifdef NDEBUG
 Messenger::~Messenger() = default;
 #else
@@ -32,49 +37,70 @@ Messenger::~Messenger() {
 }
 #endif
 
-// Check if the detectors match for the message and the delegate
+// Check if the detectors match for the message and the delegate (detectors are unique, so comparing addresses is sufficient)
+static bool check_send(const Detector* message_detector, const Detector* delegate_detector) {
+    return delegate_detector == nullptr || delegate_detector == message_detector;
+}
 static bool check_send(BaseMessage* message, BaseDelegate* delegate) {
-    if(delegate->getDetector() != nullptr &&
-       (message->getDetector() == nullptr || delegate->getDetector()->getName() != message->getDetector()->getName())) {
-        return false;
+    return check_send(message->getDetector().get(), delegate->getDetector().get());
+}
+
+const std::list<std::unique_ptr<BaseDelegate>>* Messenger::find_delegates(const std::type_index& type,
+                                                                         const std::string& id) const {
+    auto type_iter = delegates_.find(type);
+    if(type_iter == delegates_.end()) {
+        return nullptr;
     }
-    return true;
+    auto name_iter = type_iter->second.find(id);
+    if(name_iter == type_iter->second.end()) {
+        return nullptr;
+    }
+    return &name_iter->second;
 }
 
 /**
  * Messages should be bound during construction, so this function only gives useful information outside the constructor
  */
 bool Messenger::hasReceiver(Module* source, const std::shared_ptr<BaseMessage>& message) {
-    std::lock_guard<std::mutex> lock(mutex_);
-
     const BaseMessage* inst = message.get();
     std::type_index type_idx = typeid(*inst);
+    const Detector* message_detector = message->getDetector().get();
 
-    // Get the name of the output message
-    auto name = source->get_configuration().get<std::string>("output");
-
-    // Check if a normal specific listener exists
-    for(auto& delegate : delegates_[type_idx][name]) {
-        if(check_send(message.get(), delegate.get())) {
-            return true;
+    // Use the read-only routing table if it has been built already
+    if(routing_closed_) {
+        auto source_iter = routing_table_.find(source);
+        if(source_iter == routing_table_.end()) {
+            return false;
         }
-    }
-    // Check if a normal generic listener exists
-    for(auto& delegate : delegates_[type_idx]["*"]) {
-        if(check_send(message.get(), delegate.get())) {
-            return true;
-        }
-    }
-    // Check if a base message specific listener exists
-    for(auto& delegate : delegates_[typeid(BaseMessage)][name]) {
-        if(check_send(message.get(), delegate.get())) {
-            return true;
+        const std::vector<RouteTarget>* targets = &source_iter->second.generic;
+        for(auto& route : source_iter->second.typed) {
+            if(route.first == type_idx) {
+                targets = &route.second;
+                break;
+            }
         }
+        return std::any_of(targets->begin(), targets->end(), [&](const RouteTarget& target) {
+            return check_send(message_detector, target.detector);
+        });
     }
-    // Check if a base message generic listener exists
-    for(auto& delegate : delegates_[typeid(BaseMessage)]["*"]) {
-        if(check_send(message.get(), delegate.get())) {
-            return true;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Get the name of the output message
+    auto name = source->get_configuration().get<std::string>("output");
+
+    // Check for normal and base message listeners, either specific or generic
+    for(auto& type : {type_idx, std::type_index(typeid(BaseMessage))}) {
+        for(auto& id : {name, std::string("*")}) {
+            auto delegates = find_delegates(type, id);
+            if(delegates == nullptr) {
+                continue;
+            }
+            for(auto& delegate : *delegates) {
+                if(check_send(message.get(), delegate.get())) {
+                    return true;
+                }
+            }
         }
     }
 
@@ -82,23 +108,37 @@ bool Messenger::hasReceiver(Module* source, const std::shared_ptr<BaseMessage>&
 }
 
 /**
- * Send messages to all specific listeners and also to all generic listeners (listening to all incoming messages)
+ * Send messages to all specific listeners and also to all generic listeners (listening to all incoming messages). After the
+ * routing table is built, messages sent to the output of the dispatching module are delivered through the table.
  */
 void Messenger::dispatch_message(Module* source, const std::shared_ptr<BaseMessage>& message, std::string name) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    bool send = false;
 
-    // Get the name of the output message
-    if(name == "-") {
-        name = source->get_configuration().get<std::string>("output");
+    // Only messages with an explicit name differing from the module output need a lookup in the delegate map
+    const SourceRoutes* routes = nullptr;
+    if(routing_closed_) {
+        auto source_iter = routing_table_.find(source);
+        if(source_iter != routing_table_.end() && (name == "-" || name == source_iter->second.output)) {
+            routes = &source_iter->second;
+        }
     }
 
-    bool send = false;
+    if(routes != nullptr) {
+        send = dispatch_routed(source, message, *routes);
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
 
-    // Send to specific listeners
-    send = dispatch_message(source, message, name, name) || send;
+        // Get the name of the output message
+        if(name == "-") {
+            name = source->get_configuration().get<std::string>("output");
+        }
 
-    // Send to generic listeners
-    send = dispatch_message(source, message, name, "*") || send;
+        // Send to specific listeners
+        send = dispatch_message(source, message, name, name) || send;
+
+        // Send to generic listeners
+        send = dispatch_message(source, message, name, "*") || send;
+    }
 
     // Display a TRACE log message if the message is send to no receiver
     if(!send) {
@@ -108,7 +148,42 @@ void Messenger::dispatch_message(Module* source, const std::shared_ptr<BaseMessa
     }
 
     // Save a copy of the sent message
-    sent_messages_.emplace_back(message);
+    store_message(source, message);
+}
+
+/**
+ * The routes are resolved in the same order as the delegate map is traversed: specific listeners of the message type,
+ * specific listeners to all messages, generic listeners of the message type and finally generic listeners to all messages.
+ */
+bool Messenger::dispatch_routed(Module* source, const std::shared_ptr<BaseMessage>& message, const SourceRoutes& routes) {
+    const BaseMessage* inst = message.get();
+    std::type_index type_idx = typeid(*inst);
+    const Detector* message_detector = message->getDetector().get();
+
+    const std::vector<RouteTarget>* targets = &routes.generic;
+    for(auto& route : routes.typed) {
+        if(route.first == type_idx) {
+            targets = &route.second;
+            break;
+        }
+    }
+
+    bool send = false;
+    for(auto& target : *targets) {
+        if(!check_send(message_detector, target.detector)) {
+            continue;
+        }
+
+        LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from " << source->getUniqueName()
+                   << " to " << target.delegate->getUniqueName();
+
+        // Serialize the delivery only per receiving module
+        std::lock_guard<std::mutex> lock(*target.receiver_mutex);
+        target.delegate->process(message, routes.output);
+        send = true;
+    }
+
+    return send;
 }
 
 /**
@@ -124,33 +199,169 @@ bool Messenger::dispatch_message(Module* source,
     const BaseMessage* inst = message.get();
     std::type_index type_idx = typeid(*inst);
 
-    // Send messages only to their specific listeners
-    for(auto& delegate : delegates_[type_idx][id]) {
-        if(check_send(message.get(), delegate.get())) {
-            LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from " << source->getUniqueName()
-                       << " to " << delegate->getUniqueName();
+    // Deliver the message, also locking the receiving module if messages can be routed concurrently
+    auto deliver = [&](BaseDelegate* delegate) {
+        if(routing_closed_) {
+            std::lock_guard<std::mutex> lock(*delegate_mutexes_.at(delegate));
+            delegate->process(message, name);
+        } else {
             delegate->process(message, name);
-            send = true;
+        }
+    };
+
+    // Send messages only to their specific listeners
+    auto delegates = find_delegates(type_idx, id);
+    if(delegates != nullptr) {
+        for(auto& delegate : *delegates) {
+            if(check_send(message.get(), delegate.get())) {
+                LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from " << source->getUniqueName()
+                           << " to " << delegate->getUniqueName();
+                deliver(delegate.get());
+                send = true;
+            }
         }
     }
 
     // Dispatch to base message listeners
     assert(typeid(BaseMessage) != typeid(*inst));
-    for(auto& delegate : delegates_[typeid(BaseMessage)][id]) {
-        if(check_send(message.get(), delegate.get())) {
-            LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from " << source->getUniqueName()
-                       << " to generic listener " << delegate->getUniqueName();
-            delegate->process(message, name);
-            send = true;
+    delegates = find_delegates(typeid(BaseMessage), id);
+    if(delegates != nullptr) {
+        for(auto& delegate : *delegates) {
+            if(check_send(message.get(), delegate.get())) {
+                LOG(TRACE) << "Sending message " << allpix::demangle(type_idx.name()) << " from " << source->getUniqueName()
+                           << " to generic listener " << delegate->getUniqueName();
+                deliver(delegate.get());
+                send = true;
+            }
         }
     }
 
     return send;
 }
 
+void Messenger::store_message(const Module* source, const std::shared_ptr<BaseMessage>& message) {
+    std::lock_guard<std::mutex> lock(sent_messages_mutex_);
+    sent_messages_.emplace_back(message);
+    if(account_sizes_) {
+        message_sizes_[source] += message->getMemorySize();
+    }
+}
+
+void Messenger::clearMessages() {
+    std::lock_guard<std::mutex> lock(sent_messages_mutex_);
+    sent_messages_.clear();
+}
+
+void Messenger::enableSizeAccounting() {
+    account_sizes_ = true;
+}
+
+std::map<const Module*, size_t> Messenger::collectMessageSizes() {
+    std::lock_guard<std::mutex> lock(sent_messages_mutex_);
+    std::map<const Module*, size_t> sizes;
+    sizes.swap(message_sizes_);
+    return sizes;
+}
+
+/**
+ * The arena of every thread is looked up by the identifier of the messenger, a thread thus never allocates from the arena
+ * of a messenger which no longer exists.
+ */
+EventArena* Messenger::get_thread_arena() {
+    thread_local std::unordered_map<unsigned int, EventArena*> thread_arenas;
+    auto& arena = thread_arenas[arena_id_];
+    if(arena == nullptr) {
+        std::lock_guard<std::mutex> lock(arenas_mutex_);
+        arenas_.push_back(std::make_unique<EventArena>());
+        arena = arenas_.back().get();
+    }
+    return arena;
+}
+
+/**
+ * All threads have finished the event when this is called, so the arenas can be reset from the main thread.
+ */
+void Messenger::resetEventArena() {
+    std::lock_guard<std::mutex> lock(arenas_mutex_);
+    for(auto& arena : arenas_) {
+        if(!arena->reset()) {
+            LOG(TRACE) << "Messages are kept beyond the end of the event, continuing with new blocks in message arena";
+        }
+    }
+}
+
+/**
+ * Resolves the output name of every module and the matching delegates for every registered message type. The table is only
+ * read afterwards and can thus be accessed concurrently without locking the messenger.
+ */
+void Messenger::buildRoutingTable(const std::vector<Module*>& modules) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    routing_table_.clear();
+    delegate_mutexes_.clear();
+    receiver_mutexes_.clear();
+
+    // Create a lock for every receiving module
+    for(auto& module : modules) {
+        receiver_mutexes_.emplace_back(std::make_unique<std::mutex>());
+        for(auto& delegate : module->delegates_) {
+            if(delegate.first == this) {
+                delegate_mutexes_[delegate.second] = receiver_mutexes_.back().get();
+            }
+        }
+    }
+
+    // Append all delegates of a type and name to the list of targets
+    auto add_targets = [&](std::vector<RouteTarget>& targets, const std::type_index& type, const std::string& id) {
+        auto delegates = find_delegates(type, id);
+        if(delegates == nullptr) {
+            return;
+        }
+        for(auto& delegate : *delegates) {
+            targets.push_back({delegate.get(), delegate->getDetector().get(), delegate_mutexes_.at(delegate.get())});
+        }
+    };
+
+    std::type_index base_type = typeid(BaseMessage);
+    size_t num_routes = 0;
+    for(auto& module : modules) {
+        SourceRoutes routes;
+        routes.output = module->get_configuration().get<std::string>("output");
+
+        for(auto& type_delegates : delegates_) {
+            if(type_delegates.first == base_type) {
+                continue;
+            }
+
+            std::vector<RouteTarget> targets;
+            add_targets(targets, type_delegates.first, routes.output);
+            add_targets(targets, base_type, routes.output);
+            add_targets(targets, type_delegates.first, "*");
+            add_targets(targets, base_type, "*");
+            num_routes += targets.size();
+            routes.typed.emplace_back(type_delegates.first, std::move(targets));
+        }
+
+        add_targets(routes.generic, base_type, routes.output);
+        add_targets(routes.generic, base_type, "*");
+
+        routing_table_.emplace(module, std::move(routes));
+    }
+
+    routing_closed_ = true;
+    LOG(TRACE) << "Built message routing table for " << modules.size() << " modules with " << num_routes << " typed routes";
+}
+
+/**
+ * @throws InvalidModuleActionException If a delegate is added after the routing table has been built
+ */
 void Messenger::add_delegate(const std::type_info& message_type, Module* module, std::unique_ptr<BaseDelegate> delegate) {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    if(routing_closed_) {
+        throw InvalidModuleActionException("Cannot register message listeners after the module initialization");
+    }
+
     // Register generic or specific delegate depending on flag
     std::string message_name;
     if((delegate->getFlags() & MsgFlags::IGNORE_NAME) != MsgFlags::NONE) {
@@ -171,6 +382,8 @@ void Messenger::add_delegate(const std::type_info& message_type, Module* module,
 
 /**
  * @throws std::out_of_range If a delegate is removed which is never registered
+ *
+ * Removing a delegate invalidates the routing table, this only happens when the modules are destructed.
  */
 void Messenger::remove_delegate(BaseDelegate* delegate) {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -179,6 +392,13 @@ void Messenger::remove_delegate(BaseDelegate* delegate) {
     if(iter == delegate_to_iterator_.end()) {
         throw std::out_of_range("delegate not found in listeners");
     }
+
+    if(routing_closed_) {
+        routing_closed_ = false;
+        routing_table_.clear();
+        delegate_mutexes_.clear();
+    }
+
     delegates_[std::get<0>(iter->second)][std::get<1>(iter->second)].erase(std::get<2>(iter->second));
     delegate_to_iterator_.erase(iter);
 }
@@ -11,12 +11,17 @@
 #ifndef ALLPIX_MESSENGER_H
 #define ALLPIX_MESSENGER_H
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <typeindex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "EventArena.hpp"
 #include "Message.hpp"
 #include "core/module/Module.hpp"
 #include "delegates.h"
@@ -108,6 +113,26 @@ namespace allpix {
          */
         bool hasReceiver(Module* source, const std::shared_ptr<BaseMessage>& message);
 
+        /**
+         * @brief Create a message in the memory arena of the current event
+         * @param args Arguments forwarded to the constructor of the message
+         * @return Pointer to the constructed message
+         *
+         * The message and its reference count are placed in the arena of the calling thread, which is rewound at the end of
+         * the event, avoiding separate heap allocations for every message. Messages can be kept beyond the event, their
+         * memory is then only released once they are dropped.
+         */
+        template <typename T, typename... Args> std::shared_ptr<T> createMessage(Args&&... args);
+
+        /**
+         * @brief Create an empty list of objects in the memory arena of the current event
+         * @return List to be filled with objects and passed to the constructor of a message
+         *
+         * The storage of the list is allocated from the same arena as the messages created by \ref createMessage, it
+         * should only be filled by the calling thread.
+         */
+        template <typename T> MessageData<T> createMessageData();
+
         /**
          * @brief Dispatches a message
          * @param source Module dispatching the message
@@ -121,7 +146,35 @@ namespace allpix {
         /**
          * @brief Removes the list of sent messages, clearing them from memory if not otherwise used
          */
-        inline void clearMessages() { sent_messages_.clear(); }
+        void clearMessages();
+
+        /**
+         * @brief Rewind the memory arena of the messages at the end of an event
+         * @note Should only be called after all modules have \ref Module::reset_delegates "reset their delegates"
+         */
+        void resetEventArena();
+
+        /**
+         * @brief Resolve the routing of all messages into a read-only table
+         * @param modules List of all module instantiations that can dispatch messages
+         * @warning No delegates can be added after the routing table has been built
+         *
+         * After building the table, messages dispatched to the output of the source module are delivered without taking
+         * the global messenger lock, only serializing the delivery per receiving module.
+         */
+        void buildRoutingTable(const std::vector<Module*>& modules);
+
+        /**
+         * @brief Enable the accounting of the memory size of all dispatched messages per source module
+         */
+        void enableSizeAccounting();
+
+        /**
+         * @brief Collect the memory size of the messages dispatched since the last call
+         * @return Total memory size in bytes of the messages dispatched per source module
+         * @note Returns an empty map if the size accounting is not enabled
+         */
+        std::map<const Module*, size_t> collectMessageSizes();
 
     private:
         /**
@@ -159,6 +212,54 @@ namespace allpix {
                               const std::string& name,
                               const std::string& id);
 
+        /**
+         * Precompiled routing table
+         * Every delegate is stored together with the raw pointer of its detector (compared by address instead of name) and
+         * the lock of its receiving module. Routes are resolved per dispatching module for all message types with a specific
+         * listener, the generic routes are used for all other types (only listeners to the base message).
+         */
+        struct RouteTarget {
+            BaseDelegate* delegate;
+            const Detector* detector;
+            std::mutex* receiver_mutex;
+        };
+        struct SourceRoutes {
+            std::string output;
+            std::vector<std::pair<std::type_index, std::vector<RouteTarget>>> typed;
+            std::vector<RouteTarget> generic;
+        };
+
+        /**
+         * @brief Dispatch base message using the precompiled routing table
+         * @param source Dispatching module
+         * @param message Message to dispatch
+         * @param routes Routes resolved for the dispatching module
+         * @return True if the message was received by at least one delegate, false otherwise
+         */
+        bool dispatch_routed(Module* source, const std::shared_ptr<BaseMessage>& message, const SourceRoutes& routes);
+
+        /**
+         * @brief Fetch the list of delegates for a message type and name without modifying the delegate map
+         * @param type Type index of the message
+         * @param id Name of the message or '*' for the generic listeners
+         * @return Pointer to the list of delegates or a null pointer if no delegate is registered
+         */
+        const std::list<std::unique_ptr<BaseDelegate>>* find_delegates(const std::type_index& type,
+                                                                      const std::string& id) const;
+
+        /**
+         * @brief Store a dispatched message until the end of the event
+         * @param source Module which dispatched the message
+         * @param message Message to keep alive
+         */
+        void store_message(const Module* source, const std::shared_ptr<BaseMessage>& message);
+
+        /**
+         * @brief Get the memory arena of the calling thread, creating it on first use
+         * @return Arena owned by the calling thread
+         */
+        EventArena* get_thread_arena();
+
         using DelegateMap = std::map<std::type_index, std::map<std::string, std::list<std::unique_ptr<BaseDelegate>>>>;
         using DelegateIteratorMap =
             std::map<BaseDelegate*,
@@ -166,9 +267,22 @@ namespace allpix {
 
         DelegateMap delegates_;
         DelegateIteratorMap delegate_to_iterator_;
+
+        // Memory arenas of all threads creating messages, only the arenas themselves are accessed by their owning thread
+        std::vector<std::unique_ptr<EventArena>> arenas_;
+        std::mutex arenas_mutex_;
+        unsigned int arena_id_;
         std::vector<std::shared_ptr<BaseMessage>> sent_messages_;
+        std::map<const Module*, size_t> message_sizes_;
+        std::atomic_bool account_sizes_{false};
+
+        std::unordered_map<const Module*, SourceRoutes> routing_table_;
+        std::unordered_map<const BaseDelegate*, std::mutex*> delegate_mutexes_;
+        std::vector<std::unique_ptr<std::mutex>> receiver_mutexes_;
+        std::atomic_bool routing_closed_{false};
 
         mutable std::mutex mutex_;
+        std::mutex sent_messages_mutex_;
     };
 } // namespace allpix
 
@@ -15,6 +15,15 @@ namespace allpix {
         dispatch_message(source, std::static_pointer_cast<BaseMessage>(message), name);
     }
 
+    template <typename T, typename... Args> std::shared_ptr<T> Messenger::createMessage(Args&&... args) {
+        static_assert(std::is_base_of<BaseMessage, T>::value, "Created message should inherit from Message class");
+        return std::allocate_shared<T>(ArenaAllocator<T>(get_thread_arena()), std::forward<Args>(args)...);
+    }
+
+    template <typename T> MessageData<T> Messenger::createMessageData() {
+        return MessageData<T>(ArenaAllocator<T>(get_thread_arena()));
+    }
+
     template <typename T>
     void Messenger::registerListener(T* receiver,
                                      void (T::*method)(std::shared_ptr<BaseMessage>, std::string name),
@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @brief Implementation of the access to the hardware performance counters
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "HardwareCounters.hpp"
+
+#ifdef __linux__
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace allpix;
+
+HardwareCounters::Values& HardwareCounters::Values::operator+=(const Values& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+}
+
+HardwareCounters::Values HardwareCounters::Values::operator-(const Values& other) const {
+    // Counters of a thread only increase, but guard against reads from different threads
+    auto diff = [](uint64_t lhs, uint64_t rhs) { return (lhs > rhs ? lhs - rhs : 0); };
+
+    Values values;
+    values.cycles = diff(cycles, other.cycles);
+    values.instructions = diff(instructions, other.instructions);
+    values.cache_misses = diff(cache_misses, other.cache_misses);
+    values.branch_misses = diff(branch_misses, other.branch_misses);
+    return values;
+}
+
+#ifdef __linux__
+namespace {
+    /**
+     * @brief File descriptors of the counters of a single thread, closed when the thread exits
+     */
+    class ThreadCounters {
+    public:
+        ThreadCounters() { file_descriptors_.fill(-1); }
+        ~ThreadCounters() {
+            for(auto fd : file_descriptors_) {
+                if(fd != -1) {
+                    close(fd);
+                }
+            }
+        }
+        ThreadCounters(const ThreadCounters&) = delete;
+        ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+        /**
+         * @brief Open the counters of the calling thread if this was not tried before
+         * @return Empty string on success, otherwise the error why the mandatory cycle counter cannot be opened
+         */
+        std::string open() {
+            if(opened_) {
+                return error_;
+            }
+            opened_ = true;
+
+            // Cycles, instructions, last-level cache read misses and branch misses
+            const std::array<std::pair<uint32_t, uint64_t>, 4> events{
+                {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                 {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                 {PERF_TYPE_HW_CACHE,
+                  PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+                 {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}}};
+
+            for(size_t i = 0; i < events.size(); ++i) {
+                struct perf_event_attr attr {};
+                attr.size = sizeof(attr);
+                attr.type = events[i].first;
+                attr.config = events[i].second;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                // Count the calling thread on any processor
+                auto fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+                if(fd == -1 && i == 0) {
+                    error_ = std::strerror(errno);
+                    return error_;
+                }
+                // Other counters are optional, as not every processor supports all of them
+                file_descriptors_[i] = fd;
+            }
+            return error_;
+        }
+
+        /**
+         * @brief Read the current values of all opened counters
+         */
+        HardwareCounters::Values read() {
+            HardwareCounters::Values values;
+            values.cycles = read_counter(0);
+            values.instructions = read_counter(1);
+            values.cache_misses = read_counter(2);
+            values.branch_misses = read_counter(3);
+            return values;
+        }
+
+    private:
+        uint64_t read_counter(size_t index) {
+            if(file_descriptors_[index] == -1) {
+                return 0;
+            }
+
+            // Value, time enabled and time running of the counter
+            std::array<uint64_t, 3> data{};
+            if(::read(file_descriptors_[index], data.data(), sizeof(data)) != sizeof(data)) {
+                return 0;
+            }
+
+            // Scale the value if the counter was multiplexed with other counters
+            if(data[2] == 0) {
+                return 0;
+            }
+            if(data[2] < data[1]) {
+                return static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                             static_cast<double>(data[2]));
+            }
+            return data[0];
+        }
+
+        std::array<int, 4> file_descriptors_{};
+        bool opened_{};
+        std::string error_;
+    };
+
+    thread_local ThreadCounters thread_counters;
+} // namespace
+
+HardwareCounters::HardwareCounters() {
+    error_ = thread_counters.open();
+    available_ = error_.empty();
+}
+
+HardwareCounters::Values HardwareCounters::read() const {
+    if(!available_ || !thread_counters.open().empty()) {
+        return {};
+    }
+    return thread_counters.read();
+}
+#else
+HardwareCounters::HardwareCounters() : error_("not supported on this platform") {}
+
+HardwareCounters::Values HardwareCounters::read() const {
+    return {};
+}
+#endif
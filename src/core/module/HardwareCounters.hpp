@@ -0,0 +1,71 @@
+/**
+ * @file
+ * @brief Access to the hardware performance counters of the processor
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_HARDWARE_COUNTERS_H
+#define ALLPIX_HARDWARE_COUNTERS_H
+
+#include <cstdint>
+#include <string>
+
+namespace allpix {
+    /**
+     * @brief Reads the hardware performance counters of the calling thread
+     *
+     * The counters are opened using the perf_event_open system call of Linux, separately for every thread on its first
+     * read. They only count events in user space of the calling thread, work executed by other threads (for example tasks
+     * submitted to the thread pool) is not included. If the counters are multiplexed by the kernel, the values are scaled
+     * to the full time the counters were enabled. On other systems, or if the access to the counters is not permitted, the
+     * counters are not available and all values read are zero.
+     */
+    class HardwareCounters {
+    public:
+        /**
+         * @brief Values of all counters
+         */
+        struct Values {
+            uint64_t cycles{};
+            uint64_t instructions{};
+            uint64_t cache_misses{};
+            uint64_t branch_misses{};
+
+            Values& operator+=(const Values& other);
+            Values operator-(const Values& other) const;
+        };
+
+        /**
+         * @brief Construct the counters, checking if they can be opened for the calling thread
+         */
+        HardwareCounters();
+
+        /**
+         * @brief Check if the hardware counters can be used
+         * @return True if the counters are available, false otherwise
+         */
+        bool isAvailable() const { return available_; }
+
+        /**
+         * @brief Get the reason why the counters are not available
+         * @return Description of the error while opening the counters
+         */
+        const std::string& getError() const { return error_; }
+
+        /**
+         * @brief Read the current values of the counters of the calling thread
+         * @return Values counted since the counters of the thread have been opened
+         */
+        Values read() const;
+
+    private:
+        bool available_{};
+        std::string error_;
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_HARDWARE_COUNTERS_H */
@@ -90,7 +90,11 @@ std::string Module::createOutputFile(const std::string& path, bool global, bool
         file += "/";
         file += path;
 
-        if(path_is_file(file)) {
+        // Keep the output written before the checkpoint if the simulation is resumed
+        auto resume = getConfigManager()->getGlobalConfiguration().get<bool>("resume", false);
+        if(path_is_file(file) && resume && checkpoint_ && !delete_file) {
+            LOG(INFO) << "File " << file << " exists and will be continued from the checkpoint.";
+        } else if(path_is_file(file)) {
             auto global_overwrite = getConfigManager()->getGlobalConfiguration().get<bool>("deny_overwrite", false);
             if(config_.get<bool>("deny_overwrite", global_overwrite)) {
                 throw ModuleError("Overwriting of existing file " + file + " denied.");
@@ -137,6 +141,24 @@ uint64_t Module::getRandomSeed() {
     return random_generator_();
 }
 
+/**
+ * The seed of every event only depends on the seed of the module and the event number. Any range of events can thus be
+ * simulated independently, for example by the worker processes of a split simulation, with the same results as in a single
+ * run over all events.
+ */
+void Module::set_event_seed(unsigned int event_num) {
+    auto seed = config_.get<uint64_t>("_seed");
+    std::seed_seq seed_seq({seed, static_cast<uint64_t>(event_num)});
+    random_generator_.seed(seed_seq);
+
+    initialized_random_generator_ = true;
+    event_seeds_ = true;
+}
+
+bool Module::hasEventSeeds() const {
+    return event_seeds_;
+}
+
 /**
  * @throws InvalidModuleActionException If the thread pool is accessed outside the run-method
  * @warning Any multithreaded task should be carefully checked to ensure it is thread-safe
@@ -194,6 +216,24 @@ bool Module::canParallelize() {
 void Module::enable_parallelization() {
     parallelize_ = true;
 }
+bool Module::canParallelizeInitialization() {
+    return parallelize_init_;
+}
+void Module::enable_parallel_initialization() {
+    parallelize_init_ = true;
+}
+const std::vector<std::string>& Module::getInitDependencies() const {
+    return init_dependencies_;
+}
+void Module::add_init_dependency(std::string module_name) {
+    init_dependencies_.push_back(std::move(module_name));
+}
+bool Module::canCheckpoint() {
+    return checkpoint_;
+}
+void Module::enable_checkpointing() {
+    checkpoint_ = true;
+}
 
 Configuration& Module::get_configuration() {
     return config_;
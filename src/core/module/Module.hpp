@@ -10,6 +10,7 @@
 #ifndef ALLPIX_MODULE_H
 #define ALLPIX_MODULE_H
 
+#include <iostream>
 #include <memory>
 #include <random>
 #include <string>
@@ -109,9 +110,19 @@ namespace allpix {
         /**
          * @brief Get seed to initialize random generators
          * @warning This should be the only method used by modules to seed random numbers to allow reproducing results
+         *
+         * If event seeds are enabled, the seeds are derived from the seed of the module and the number of the current event
+         * during the event loop. Modules should then seed their random generators at the start of every event to make the
+         * event independent of the events simulated before, see \ref Module::hasEventSeeds.
          */
         uint64_t getRandomSeed();
 
+        /**
+         * @brief Returns if the random seeds are derived from the number of the current event
+         * @return True if the global parameter event_seeds is enabled, false otherwise (the default)
+         */
+        bool hasEventSeeds() const;
+
         /**
          * @brief Get thread pool to submit asynchronous tasks to
          */
@@ -135,6 +146,24 @@ namespace allpix {
          */
         bool canParallelize();
 
+        /**
+         * @brief Returns if the initialization of this module can run in parallel to other modules
+         * @return True if parallel initialization is enabled, false otherwise (the default)
+         */
+        bool canParallelizeInitialization();
+
+        /**
+         * @brief Get the names of the modules which have to be initialized before this module
+         * @return List of module names declared with \ref Module::add_init_dependency
+         */
+        const std::vector<std::string>& getInitDependencies() const;
+
+        /**
+         * @brief Returns if this module can store its state in a checkpoint to resume the simulation later
+         * @return True if checkpointing is enabled, false otherwise (the default)
+         */
+        bool canCheckpoint();
+
         /**
          * @brief Initialize the module before the event sequence
          *
@@ -159,12 +188,53 @@ namespace allpix {
          */
         virtual void finalize() {}
 
+        /**
+         * @brief Store the state of the module needed to continue the event sequence after the last finished event
+         * @param stream Stream to write the state to
+         *
+         * Only called for modules with checkpointing enabled. Should store the random number generators used during the
+         * event sequence and the positions up to which output files have been written. Does nothing if not overloaded.
+         */
+        virtual void saveState(std::ostream& stream) { (void)stream; }
+
+        /**
+         * @brief Restore the state of the module from a checkpoint
+         * @param stream Stream to read the state from, as written by \ref Module::saveState
+         *
+         * Only called for modules with checkpointing enabled, after \ref Module::init() if the simulation is resumed. Does
+         * nothing if not overloaded.
+         */
+        virtual void loadState(std::istream& stream) { (void)stream; }
+
     protected:
         /**
          * @brief Enable parallelization for this module
          */
         void enable_parallelization();
 
+        /**
+         * @brief Enable parallel initialization of this module
+         * @warning Should only be enabled if the \ref Module::init() function only modifies the linked detector and state
+         *          which is safe to share between threads. In particular no ROOT objects should be created during init.
+         */
+        void enable_parallel_initialization();
+
+        /**
+         * @brief Declare that the initialization of this module requires another module to be initialized first
+         * @param module_name Name of the module (for example "ElectricFieldReader") which should be initialized before
+         *
+         * Only relevant for modules with parallel initialization, all other modules are initialized after every preceding
+         * module has finished its initialization.
+         */
+        void add_init_dependency(std::string module_name);
+
+        /**
+         * @brief Enable storing the state of this module in checkpoints
+         * @note Modules without internal state only have to enable it, others should also overload \ref Module::saveState
+         *       and \ref Module::loadState
+         */
+        void enable_checkpointing();
+
         /**
          * @brief Get the module configuration for internal use
          * @return Configuration of the module
@@ -222,12 +292,22 @@ namespace allpix {
         bool check_delegates();
         std::vector<std::pair<Messenger*, BaseDelegate*>> delegates_;
 
+        /**
+         * @brief Seed the random generator of the module for an event
+         * @param event_num Number of the event
+         */
+        void set_event_seed(unsigned int event_num);
+
         bool initialized_random_generator_{false};
+        bool event_seeds_{false};
         std::mt19937_64 random_generator_;
 
         std::shared_ptr<Detector> detector_;
 
         bool parallelize_{false};
+        bool parallelize_init_{false};
+        std::vector<std::string> init_dependencies_;
+        bool checkpoint_{false};
     };
 
 } // namespace allpix
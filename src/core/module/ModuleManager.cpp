@@ -14,15 +14,20 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <limits>
+#include <map>
 #include <random>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 
+#include <TH1D.h>
 #include <TProcessID.h>
 #include <TSystem.h>
 
@@ -33,6 +38,7 @@
 #include "core/messenger/Messenger.hpp"
 #include "core/utils/file.h"
 #include "core/utils/log.h"
+#include "core/utils/memory.h"
 
 // Common prefix for all modules
 // TODO [doc] Should be provided by the build system
@@ -44,21 +50,31 @@
 
 using namespace allpix;
 
-ModuleManager::ModuleManager() : terminate_(false) {}
+ModuleManager::ModuleManager() : terminate_(false) {
+#ifdef ALLPIX_STATIC_MODULES
+    // Collect the modules linked into the executable
+    register_static_modules(static_modules_);
+#endif
+}
 
 /**
  * Loads the modules specified in the configuration file. Each module is contained within its own library which is loaded
- * automatically. After that the required modules are created from the configuration.
+ * automatically, unless the modules are linked statically into the executable. After that the required modules are created
+ * from the configuration.
  */
 void ModuleManager::load(Messenger* messenger,
                          ConfigManager* conf_manager,
                          GeometryManager* geo_manager,
                          std::mt19937_64& seeder) {
-    // Store config manager and get configurations
+    // Store config manager and messenger and get configurations
     conf_manager_ = conf_manager;
+    messenger_ = messenger;
     auto& configs = conf_manager_->getModuleConfigurations();
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
 
+    // Instantiate every variant of a module separately
+    expand_variants(configs);
+
     // (Re)create the main ROOT file
     auto path = std::string(gSystem->pwd()) + "/" + global_config.get<std::string>("root_file", "modules");
     path = allpix::add_file_extension(path, "root");
@@ -78,110 +94,10 @@ void ModuleManager::load(Messenger* messenger,
 
     // Loop through all non-global configurations
     for(auto& config : configs) {
-        // Load library for each module. Libraries are named (by convention + CMAKE) libAllpixModule Name.suffix
-        std::string lib_name = std::string(ALLPIX_MODULE_PREFIX).append(config.getName()).append(SHARED_LIBRARY_SUFFIX);
         LOG_PROGRESS(STATUS, "LOAD_LOOP") << "Loading module " << config.getName();
 
-        void* lib = nullptr;
-        bool load_error = false;
-        dlerror();
-        if(loaded_libraries_.count(lib_name) == 0) {
-            // If library is not loaded then try to load it first from the config directories
-            if(global_config.has("library_directories")) {
-                std::vector<std::string> lib_paths = global_config.getPathArray("library_directories", true);
-                for(auto& lib_path : lib_paths) {
-                    std::string full_lib_path = lib_path;
-                    full_lib_path += "/";
-                    full_lib_path += lib_name;
-
-                    // Check if the absolute file exists and try to load if it exists
-                    std::ifstream check_file(full_lib_path);
-                    if(check_file.good()) {
-                        lib = dlopen(full_lib_path.c_str(), RTLD_NOW);
-                        if(lib != nullptr) {
-                            LOG(DEBUG) << "Found library in configuration specified directory at " << full_lib_path;
-                        } else {
-                            load_error = true;
-                        }
-                        break;
-                    }
-                }
-            }
-
-            // Otherwise try to load from the standard paths if not found already
-            if(!load_error && lib == nullptr) {
-                lib = dlopen(lib_name.c_str(), RTLD_NOW);
-
-                if(lib != nullptr) {
-                    Dl_info dl_info;
-                    dl_info.dli_fname = "";
-
-                    // workaround to get the location of the library
-                    int ret = dladdr(dlsym(lib, ALLPIX_UNIQUE_FUNCTION), &dl_info);
-                    if(ret != 0) {
-                        LOG(DEBUG) << "Found library during global search in runtime paths at " << dl_info.dli_fname;
-                    } else {
-                        LOG(WARNING)
-                            << "Found library during global search but could not deduce location, likely broken library";
-                    }
-                } else {
-                    load_error = true;
-                }
-            }
-        } else {
-            // Otherwise just fetch it from the cache
-            lib = loaded_libraries_[lib_name];
-        }
-
-        // If library did not load then throw exception
-        if(load_error) {
-            const char* lib_error = dlerror();
-
-            // Find the name of the loaded library if it exists
-            std::string lib_error_str = lib_error;
-            size_t end_pos = lib_error_str.find(':');
-            std::string problem_lib;
-            if(end_pos != std::string::npos) {
-                problem_lib = lib_error_str.substr(0, end_pos);
-            }
-
-            // FIXME is checking the error in this way portable?
-            if(lib_error != nullptr && std::strstr(lib_error, "cannot allocate memory in static TLS block") != nullptr) {
-                LOG(ERROR) << "Library could not be loaded: not enough thread local storage available" << std::endl
-                           << "Try one of below workarounds:" << std::endl
-                           << "- Rerun library with the environmental variable LD_PRELOAD='" << problem_lib << "'"
-                           << std::endl
-                           << "- Recompile the library " << problem_lib << " with tls-model=global-dynamic";
-            } else if(lib_error != nullptr && std::strstr(lib_error, "cannot open shared object file") != nullptr &&
-                      problem_lib.find(ALLPIX_MODULE_PREFIX) == std::string::npos) {
-                LOG(ERROR) << "Library could not be loaded: one of its dependencies is missing" << std::endl
-                           << "The name of the missing library is " << problem_lib << std::endl
-                           << "Please make sure the library is properly initialized and try again";
-            } else {
-                LOG(ERROR) << "Library could not be loaded: it is not available" << std::endl
-                           << " - Did you enable the library during building? " << std::endl
-                           << " - Did you spell the library name correctly (case-sensitive)? ";
-                if(lib_error != nullptr) {
-                    LOG(DEBUG) << "Detailed error: " << lib_error;
-                }
-            }
-
-            throw allpix::DynamicLibraryError(config.getName());
-        }
-        // Remember that this library was loaded
-        loaded_libraries_[lib_name] = lib;
-
-        // Check if this module is produced once, or once per detector
-        bool unique = true;
-        void* uniqueFunction = dlsym(loaded_libraries_[lib_name], ALLPIX_UNIQUE_FUNCTION);
-
-        // If the unique function was not found, throw an error
-        if(uniqueFunction == nullptr) {
-            LOG(ERROR) << "Module library is invalid or outdated: required interface function not found!";
-            throw allpix::DynamicLibraryError(config.getName());
-        } else {
-            unique = reinterpret_cast<bool (*)()>(uniqueFunction)(); // NOLINT
-        }
+        // Get the functions to instantiate the module, either linked into the executable or from its library
+        auto factory = load_module_factory(config);
 
         // Add the global internal parameters to the configuration
         std::string global_dir = gSystem->pwd();
@@ -193,11 +109,10 @@ void ModuleManager::load(Messenger* messenger,
 
         // Create the modules from the library depending on the module type
         std::vector<std::pair<ModuleIdentifier, Module*>> mod_list;
-        if(unique) {
-            mod_list.emplace_back(
-                create_unique_modules(loaded_libraries_[lib_name], config, messenger, geo_manager, seeder));
+        if(factory.unique) {
+            mod_list.emplace_back(create_unique_modules(factory.unique_generator, config, messenger, geo_manager, seeder));
         } else {
-            mod_list = create_detector_modules(loaded_libraries_[lib_name], config, messenger, geo_manager, seeder);
+            mod_list = create_detector_modules(factory.detector_generator, config, messenger, geo_manager, seeder);
         }
 
         // Loop through all created instantiations
@@ -216,6 +131,7 @@ void ModuleManager::load(Messenger* messenger,
                                << " with instance with higher priority.";
 
                     module_execution_time_.erase(iter->second->get());
+                    module_memory_.erase(iter->second->get());
                     iter->second = modules_.erase(iter->second);
                     iter = id_to_module_.erase(iter);
                 } else {
@@ -239,11 +155,215 @@ void ModuleManager::load(Messenger* messenger,
     LOG_PROGRESS(STATUS, "LOAD_LOOP") << "Loaded " << configs.size() << " modules";
 }
 
+/**
+ * Every variant of a module is configured with the parameters of the section, overwritten by the parameters prefixed with
+ * the name of the variant and a dot. The output of the variant is tagged with its name. Its input is tagged likewise if a
+ * previous module in the configuration has the same variant, such that chains of modules can be repeated for every variant
+ * while consuming the same messages from the modules before the chain.
+ */
+void ModuleManager::expand_variants(std::list<Configuration>& configs) {
+    std::set<std::string> known_variants;
+    for(auto config_iter = configs.begin(); config_iter != configs.end();) {
+        if(!config_iter->has("variants")) {
+            ++config_iter;
+            continue;
+        }
+
+        auto variants = config_iter->getArray<std::string>("variants");
+        std::set<std::string> unique_variants;
+        for(auto& variant : variants) {
+            auto valid_char = [](char ch) { return std::isalnum(static_cast<unsigned char>(ch)) != 0 || ch == '_'; };
+            if(variant.empty() || !std::all_of(variant.begin(), variant.end(), valid_char)) {
+                throw InvalidValueError(*config_iter,
+                                        "variants",
+                                        "name '" + variant + "' should only contain alphanumerics and underscores");
+            }
+            if(!unique_variants.insert(variant).second) {
+                throw InvalidValueError(*config_iter, "variants", "name '" + variant + "' is used more than once");
+            }
+        }
+
+        // Insert the configuration of every variant in place of the original configuration
+        for(auto& variant : variants) {
+            Configuration variant_config = *config_iter;
+
+            // Overwrite the parameters specific to this variant
+            auto prefix = variant + ".";
+            for(auto& key_value : config_iter->getAll()) {
+                if(key_value.first.size() > prefix.size() && key_value.first.compare(0, prefix.size(), prefix) == 0) {
+                    variant_config.setText(key_value.first.substr(prefix.size()), key_value.second);
+                }
+            }
+
+            // Tag the output and take the input from previous modules of the same variant
+            auto output = variant_config.get<std::string>("output", "");
+            variant_config.set<std::string>("output", output.empty() ? variant : output + "_" + variant);
+            if(!variant_config.has("input") && known_variants.find(variant) != known_variants.end()) {
+                variant_config.set<std::string>("input", variant);
+            }
+
+            LOG(DEBUG) << "Adding variant " << variant << " of module " << config_iter->getName() << " with input '"
+                       << variant_config.get<std::string>("input", "") << "' and output '"
+                       << variant_config.get<std::string>("output") << "'";
+            configs.insert(config_iter, std::move(variant_config));
+        }
+
+        known_variants.insert(variants.begin(), variants.end());
+        config_iter = configs.erase(config_iter);
+    }
+}
+
+/**
+ * @throws DynamicLibraryError If the module is not available
+ *
+ * If the modules are linked statically into the executable, the factory is taken from the registry of the executable.
+ * Otherwise each module is contained within its own library, which is loaded from the configured library directories or
+ * the standard library paths.
+ */
+ModuleFactory ModuleManager::load_module_factory(const Configuration& config) {
+#ifdef ALLPIX_STATIC_MODULES
+    const ModuleFactory* factory = static_modules_.find(config.getName());
+    if(factory == nullptr) {
+        LOG(ERROR) << "Module is not available in this executable" << std::endl
+                   << " - Did you enable the module during building? " << std::endl
+                   << " - Did you spell the module name correctly (case-sensitive)? " << std::endl
+                   << " - External modules cannot be loaded into executables built with BUILD_STATIC_EXECUTABLE";
+        throw allpix::DynamicLibraryError(config.getName());
+    }
+    return *factory;
+#else
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+
+    // Load library for each module. Libraries are named (by convention + CMAKE) libAllpixModule Name.suffix
+    std::string lib_name = std::string(ALLPIX_MODULE_PREFIX).append(config.getName()).append(SHARED_LIBRARY_SUFFIX);
+
+    void* lib = nullptr;
+    bool load_error = false;
+    dlerror();
+    if(loaded_libraries_.count(lib_name) == 0) {
+        // If library is not loaded then try to load it first from the config directories
+        if(global_config.has("library_directories")) {
+            std::vector<std::string> lib_paths = global_config.getPathArray("library_directories", true);
+            for(auto& lib_path : lib_paths) {
+                std::string full_lib_path = lib_path;
+                full_lib_path += "/";
+                full_lib_path += lib_name;
+
+                // Check if the absolute file exists and try to load if it exists
+                std::ifstream check_file(full_lib_path);
+                if(check_file.good()) {
+                    lib = dlopen(full_lib_path.c_str(), RTLD_NOW);
+                    if(lib != nullptr) {
+                        LOG(DEBUG) << "Found library in configuration specified directory at " << full_lib_path;
+                    } else {
+                        load_error = true;
+                    }
+                    break;
+                }
+            }
+        }
+
+        // Otherwise try to load from the standard paths if not found already
+        if(!load_error && lib == nullptr) {
+            lib = dlopen(lib_name.c_str(), RTLD_NOW);
+
+            if(lib != nullptr) {
+                Dl_info dl_info;
+                dl_info.dli_fname = "";
+
+                // workaround to get the location of the library
+                int ret = dladdr(dlsym(lib, ALLPIX_UNIQUE_FUNCTION), &dl_info);
+                if(ret != 0) {
+                    LOG(DEBUG) << "Found library during global search in runtime paths at " << dl_info.dli_fname;
+                } else {
+                    LOG(WARNING)
+                        << "Found library during global search but could not deduce location, likely broken library";
+                }
+            } else {
+                load_error = true;
+            }
+        }
+    } else {
+        // Otherwise just fetch it from the cache
+        lib = loaded_libraries_[lib_name];
+    }
+
+    // If library did not load then throw exception
+    if(load_error) {
+        const char* lib_error = dlerror();
+
+        // Find the name of the loaded library if it exists
+        std::string lib_error_str = lib_error;
+        size_t end_pos = lib_error_str.find(':');
+        std::string problem_lib;
+        if(end_pos != std::string::npos) {
+            problem_lib = lib_error_str.substr(0, end_pos);
+        }
+
+        // FIXME is checking the error in this way portable?
+        if(lib_error != nullptr && std::strstr(lib_error, "cannot allocate memory in static TLS block") != nullptr) {
+            LOG(ERROR) << "Library could not be loaded: not enough thread local storage available" << std::endl
+                       << "Try one of below workarounds:" << std::endl
+                       << "- Rerun library with the environmental variable LD_PRELOAD='" << problem_lib << "'"
+                       << std::endl
+                       << "- Recompile the library " << problem_lib << " with tls-model=global-dynamic";
+        } else if(lib_error != nullptr && std::strstr(lib_error, "cannot open shared object file") != nullptr &&
+                  problem_lib.find(ALLPIX_MODULE_PREFIX) == std::string::npos) {
+            LOG(ERROR) << "Library could not be loaded: one of its dependencies is missing" << std::endl
+                       << "The name of the missing library is " << problem_lib << std::endl
+                       << "Please make sure the library is properly initialized and try again";
+        } else {
+            LOG(ERROR) << "Library could not be loaded: it is not available" << std::endl
+                       << " - Did you enable the library during building? " << std::endl
+                       << " - Did you spell the library name correctly (case-sensitive)? ";
+            if(lib_error != nullptr) {
+                LOG(DEBUG) << "Detailed error: " << lib_error;
+            }
+        }
+
+        throw allpix::DynamicLibraryError(config.getName());
+    }
+    // Remember that this library was loaded
+    loaded_libraries_[lib_name] = lib;
+
+    // Check if this module is produced once, or once per detector
+    ModuleFactory factory;
+    void* uniqueFunction = dlsym(loaded_libraries_[lib_name], ALLPIX_UNIQUE_FUNCTION);
+
+    // If the unique function was not found, throw an error
+    if(uniqueFunction == nullptr) {
+        LOG(ERROR) << "Module library is invalid or outdated: required interface function not found!";
+        throw allpix::DynamicLibraryError(config.getName());
+    } else {
+        factory.unique = reinterpret_cast<bool (*)()>(uniqueFunction)(); // NOLINT
+    }
+
+    // Get the generator function for this module
+    void* generator = dlsym(loaded_libraries_[lib_name], ALLPIX_GENERATOR_FUNCTION);
+    // If the generator function was not found, throw an error
+    if(generator == nullptr) {
+        LOG(ERROR) << "Module library is invalid or outdated: required interface function not found!";
+        throw allpix::DynamicLibraryError(config.getName());
+    }
+
+    // Convert to correct generator function
+    if(factory.unique) {
+        factory.unique_generator = reinterpret_cast<ModuleFactory::UniqueGenerator>(generator); // NOLINT
+    } else {
+        factory.detector_generator = reinterpret_cast<ModuleFactory::DetectorGenerator>(generator); // NOLINT
+    }
+    return factory;
+#endif
+}
+
 /**
  * For unique modules a single instance is created per section
  */
-std::pair<ModuleIdentifier, Module*> ModuleManager::create_unique_modules(
-    void* library, Configuration& config, Messenger* messenger, GeometryManager* geo_manager, std::mt19937_64& seeder) {
+std::pair<ModuleIdentifier, Module*> ModuleManager::create_unique_modules(ModuleFactory::UniqueGenerator module_generator,
+                                                                          Configuration& config,
+                                                                          Messenger* messenger,
+                                                                          GeometryManager* geo_manager,
+                                                                          std::mt19937_64& seeder) {
     // Make the vector to return
     std::string module_name = config.getName();
 
@@ -268,14 +388,6 @@ std::pair<ModuleIdentifier, Module*> ModuleManager::create_unique_modules(
     }
     ModuleIdentifier identifier(module_name, identifier_str, 0);
 
-    // Get the generator function for this module
-    void* generator = dlsym(library, ALLPIX_GENERATOR_FUNCTION);
-    // If the generator function was not found, throw an error
-    if(generator == nullptr) {
-        LOG(ERROR) << "Module library is invalid or outdated: required interface function not found!";
-        throw allpix::DynamicLibraryError(module_name);
-    }
-
     // Create and add module instance config
     Configuration& instance_config = conf_manager_->addInstanceConfiguration(identifier, config);
 
@@ -288,9 +400,6 @@ std::pair<ModuleIdentifier, Module*> ModuleManager::create_unique_modules(
     std::replace(path_mod_name.begin(), path_mod_name.end(), ':', '_');
     output_dir += path_mod_name;
 
-    // Convert to correct generator function
-    auto module_generator = reinterpret_cast<Module* (*)(Configuration&, Messenger*, GeometryManager*)>(generator); // NOLINT
-
     LOG(DEBUG) << "Creating unique instantiation " << identifier.getUniqueName();
 
     // Get current time
@@ -324,8 +433,12 @@ std::pair<ModuleIdentifier, Module*> ModuleManager::create_unique_modules(
  * For detector modules multiple instantiations may be created per section. An instantiation is created for every detector if
  * no selection parameters are provided. Otherwise instantiations are created for every linked detector name and type.
  */
-std::vector<std::pair<ModuleIdentifier, Module*>> ModuleManager::create_detector_modules(
-    void* library, Configuration& config, Messenger* messenger, GeometryManager* geo_manager, std::mt19937_64& seeder) {
+std::vector<std::pair<ModuleIdentifier, Module*>>
+ModuleManager::create_detector_modules(ModuleFactory::DetectorGenerator module_generator,
+                                       Configuration& config,
+                                       Messenger* messenger,
+                                       GeometryManager* geo_manager,
+                                       std::mt19937_64& seeder) {
     std::string module_name = config.getName();
     LOG(DEBUG) << "Creating instantions for detector module " << module_name;
 
@@ -340,17 +453,6 @@ std::vector<std::pair<ModuleIdentifier, Module*>> ModuleManager::create_detector
         identifier += config.get<std::string>("output");
     }
 
-    // Open the library and get the module generator function
-    void* generator = dlsym(library, ALLPIX_GENERATOR_FUNCTION);
-    // If the generator function was not found, throw an error
-    if(generator == nullptr) {
-        LOG(ERROR) << "Module library is invalid or outdated: required interface function not found!";
-        throw allpix::DynamicLibraryError(module_name);
-    }
-    // Convert to correct generator function
-    auto module_generator =
-        reinterpret_cast<Module* (*)(Configuration&, Messenger*, std::shared_ptr<Detector>)>(generator); // NOLINT
-
     // Handle empty type and name arrays:
     bool instances_created = false;
     std::vector<std::pair<std::shared_ptr<Detector>, ModuleIdentifier>> instantiations;
@@ -504,28 +606,63 @@ void ModuleManager::set_module_after(std::tuple<LogLevel, LogFormat> prev) {
 
 /**
  * Sets the section header and logging settings before executing the  \ref Module::init() function.
- *  \ref Module::reset_delegates() "Resets" the delegates and the logging after initialization.
+ *  \ref Module::reset_delegates() "Resets" the delegates and the logging after initialization. The ROOT directories of all
+ *  modules are created upfront on the main thread. If multithreading is enabled, consecutive modules which
+ *  \ref Module::canParallelizeInitialization() "support it" are initialized in parallel unless they declared an
+ *  \ref Module::getInitDependencies() "init dependency" on a pending module, all other modules are initialized in the
+ *  order of the configuration. The message routing is resolved by the \ref Messenger once all modules are initialized.
  */
 void ModuleManager::init() {
     auto start_time = std::chrono::steady_clock::now();
-    LOG_PROGRESS(STATUS, "INIT_LOOP") << "Initializing " << modules_.size() << " module instantiations";
+
+    std::vector<Module*> module_list;
     for(auto& module : modules_) {
-        LOG_PROGRESS(TRACE, "INIT_LOOP") << "Initializing " << module->get_identifier().getUniqueName();
+        module_list.emplace_back(module.get());
+    }
+
+    // Start recording the activity of all threads if a trace is requested
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+    if(global_config.has("trace_file")) {
+        LOG(DEBUG) << "Recording trace of the thread activity";
+        trace_ = std::make_unique<TraceRecorder>();
+    }
+
+    // Account the memory used by every instantiation and the size of their messages if requested
+    memory_accounting_ = global_config.get<bool>("memory_accounting", false);
+    if(memory_accounting_) {
+        LOG(DEBUG) << "Enabling memory accounting of all module instantiations";
+        messenger_->enableSizeAccounting();
+    }
+
+    // Create a thread pool to initialize independent instantiations in parallel if multithreading is enabled
+    std::unique_ptr<ThreadPool> thread_pool;
+    auto workers = get_number_of_workers();
+    if(workers > 1) {
+        LOG(DEBUG) << "Initializing thread pool with " << (workers - 1) << " additional thread(s) for module initialization";
+        auto init_function = [log_level = Log::getReportingLevel(), log_format = Log::getFormat()]() {
+            // Initialize the threads to the same log level and format as the master setting
+            Log::setReportingLevel(log_level);
+            Log::setFormat(log_format);
+        };
+        thread_pool = std::make_unique<ThreadPool>(workers - 1, module_list, init_function, trace_.get());
+    }
 
+    // Create the ROOT directories of all modules before any initialization is dispatched to the thread pool
+    std::set<std::string> configured_names;
+    for(auto& module : modules_) {
         // Pass the config manager to this instance
         module->set_config_manager(conf_manager_);
 
         // Create main ROOT directory for this module class if it does not exists yet
-        LOG(TRACE) << "Creating and accessing ROOT directory";
-        std::string module_name = module->get_configuration().getName();
-        auto directory = modules_file_->GetDirectory(module_name.c_str());
+        LOG(TRACE) << "Creating ROOT directory for " << module->get_identifier().getUniqueName();
+        std::string module_config_name = module->get_configuration().getName();
+        auto directory = modules_file_->GetDirectory(module_config_name.c_str());
         if(directory == nullptr) {
-            directory = modules_file_->mkdir(module_name.c_str());
+            directory = modules_file_->mkdir(module_config_name.c_str());
             if(directory == nullptr) {
-                throw RuntimeError("Cannot create or access overall ROOT directory for module " + module_name);
+                throw RuntimeError("Cannot create or access overall ROOT directory for module " + module_config_name);
             }
         }
-        directory->cd();
 
         // Create local directory for this instance
         TDirectory* local_directory = nullptr;
@@ -537,39 +674,124 @@ void ModuleManager::init() {
                 throw RuntimeError("Cannot create or access local ROOT directory for module " + module->getUniqueName());
             }
         }
-
-        // Change to the directory and save it in the module
-        local_directory->cd();
         module->set_ROOT_directory(local_directory);
 
-        // Get current time
-        auto start = std::chrono::steady_clock::now();
-        // Set init module section header
-        std::string old_section_name = Log::getSection();
-        std::string section_name = "I:";
-        section_name += module->get_identifier().getUniqueName();
-        Log::setSection(section_name);
-        // Set module specific settings
-        auto old_settings = set_module_before(module->get_identifier().getUniqueName(), module->get_configuration());
-        // Change to our ROOT directory
-        module->getROOTDirectory()->cd();
-        // Init module
-        module->init();
-        // Reset delegates
-        LOG(TRACE) << "Resetting messages";
-        module->reset_delegates();
-        // Reset logging
-        Log::setSection(old_section_name);
-        set_module_after(old_settings);
-        // Update execution time
-        auto end = std::chrono::steady_clock::now();
-        module_execution_time_[module.get()] += static_cast<std::chrono::duration<long double>>(end - start).count();
+        // Insert the execution time and memory usage before the module is possibly initialized concurrently
+        module_execution_time_[module.get()];
+        module_memory_[module.get()];
+        module_skipped_[module.get()];
+
+        // Dependencies can only be resolved on modules which are initialized before
+        for(auto& dependency : module->getInitDependencies()) {
+            if(configured_names.find(dependency) == configured_names.end() &&
+               std::any_of(modules_.begin(), modules_.end(), [&](const auto& other) {
+                   return other->get_identifier().getName() == dependency;
+               })) {
+                throw InvalidModuleStateException("Module " + module->getUniqueName() + " depends on " + dependency +
+                                                  " which is only initialized afterwards");
+            }
+        }
+        configured_names.insert(module->get_identifier().getName());
+    }
+
+    LOG_PROGRESS(STATUS, "INIT_LOOP") << "Initializing " << modules_.size() << " module instantiations";
+    std::set<std::string> pending_names;
+    for(auto& module : modules_) {
+        LOG_PROGRESS(TRACE, "INIT_LOOP") << "Initializing " << module->get_identifier().getUniqueName();
+        bool parallel = (thread_pool != nullptr && module->canParallelizeInitialization());
+
+        // Finish the pending initializations if this module depends on one of them
+        if(parallel && std::any_of(module->getInitDependencies().begin(),
+                                   module->getInitDependencies().end(),
+                                   [&](const auto& dependency) { return pending_names.count(dependency) != 0; })) {
+            LOG(TRACE) << "Waiting for the initialization of the dependencies of " << module->getUniqueName();
+            thread_pool->execute_all();
+            pending_names.clear();
+        }
+
+        auto init_module = [module = module.get(), parallel, this]() {
+            // Get current time and memory
+            auto start = std::chrono::steady_clock::now();
+            auto start_memory = (memory_accounting_ ? get_current_memory() : 0);
+            auto start_peak = (memory_accounting_ ? get_peak_memory() : 0);
+            // Set init module section header
+            std::string old_section_name = Log::getSection();
+            std::string section_name = "I:";
+            section_name += module->get_identifier().getUniqueName();
+            Log::setSection(section_name);
+            // Set module specific settings
+            auto old_settings = set_module_before(module->get_identifier().getUniqueName(), module->get_configuration());
+            // Change to our ROOT directory, modules initialized in parallel are not allowed to use the current directory
+            if(!parallel) {
+                module->getROOTDirectory()->cd();
+            }
+            // Init module
+            module->init();
+            // Reset delegates
+            LOG(TRACE) << "Resetting messages";
+            module->reset_delegates();
+            // Reset logging
+            Log::setSection(old_section_name);
+            set_module_after(old_settings);
+            // Update execution time
+            auto end = std::chrono::steady_clock::now();
+            module_execution_time_.at(module) += static_cast<std::chrono::duration<long double>>(end - start).count();
+            if(trace_ != nullptr) {
+                trace_->addSpan(module->get_identifier().getUniqueName(), "init", start, end);
+            }
+            if(memory_accounting_) {
+                record_memory_usage(module, &MemoryUsage::init, start_memory, start_peak);
+            }
+        };
+
+        if(parallel) {
+            // Submit the initialization
+            thread_pool->submit_module_function(init_module);
+            pending_names.insert(module->get_identifier().getName());
+        } else {
+            // Finish all pending initializations
+            if(thread_pool != nullptr) {
+                thread_pool->execute_all();
+                pending_names.clear();
+            }
+            // Initialize current module
+            init_module();
+        }
+    }
+
+    // Finish the remaining initializations and destroy the pool
+    if(thread_pool != nullptr) {
+        thread_pool->execute_all();
+        thread_pool.reset();
     }
     LOG_PROGRESS(STATUS, "INIT_LOOP") << "Initialized " << modules_.size() << " module instantiations";
+
+    // Resolve the message routing between all instantiations now that all listeners are registered
+    messenger_->buildRoutingTable(module_list);
+
     auto end_time = std::chrono::steady_clock::now();
     total_time_ += static_cast<std::chrono::duration<long double>>(end_time - start_time).count();
 }
 
+/**
+ * @throws InvalidValueError If the number of workers is set to zero
+ */
+unsigned int ModuleManager::get_number_of_workers() {
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+
+    global_config.setDefault("experimental_multithreading", false);
+    if(!global_config.get<bool>("experimental_multithreading")) {
+        return 0;
+    }
+
+    // Try to fetch a suitable number of workers if multithreading is enabled
+    auto workers = global_config.get<unsigned int>("workers", std::max(std::thread::hardware_concurrency(), 1u));
+    if(workers == 0) {
+        throw InvalidValueError(global_config, "workers", "number of workers should be strictly more than zero");
+    }
+    return workers;
+}
+
 /**
  * Initializes the thread pool for executing multiple modules and module tasks in parallel. The run for a module is skipped
  * if its delegates are not \ref Module::check_delegates() "satisfied". Sets the section header and logging settings before
@@ -579,20 +801,11 @@ void ModuleManager::init() {
 void ModuleManager::run() {
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
 
-    global_config.setDefault("experimental_multithreading", false);
-    unsigned int threads_num;
-
-    if(global_config.get<bool>("experimental_multithreading")) {
-        // Try to fetch a suitable number of workers if multithreading is enabled
-        threads_num = global_config.get<unsigned int>("workers", std::max(std::thread::hardware_concurrency(), 1u));
-        if(threads_num == 0) {
-            throw InvalidValueError(global_config, "workers", "number of workers should be strictly more than zero");
-        }
+    // Fetch the number of workers, defaulting to no additional thread without multithreading
+    unsigned int threads_num = get_number_of_workers();
+    if(threads_num > 0) {
         LOG(WARNING) << "Experimental multithreading enabled - using " << threads_num << " worker threads.";
         --threads_num;
-    } else {
-        // Default to no additional thread without multithreading
-        threads_num = 0;
     }
 
     // Creates the thread pool
@@ -606,21 +819,99 @@ void ModuleManager::run() {
         Log::setReportingLevel(log_level);
         Log::setFormat(log_format);
     };
-    std::shared_ptr<ThreadPool> thread_pool = std::make_shared<ThreadPool>(threads_num, module_list, init_function);
+    std::shared_ptr<ThreadPool> thread_pool =
+        std::make_shared<ThreadPool>(threads_num, module_list, init_function, trace_.get());
     for(auto& module : modules_) {
         module->set_thread_pool(thread_pool);
     }
 
+    // Create histograms of the execution time per event if requested, the range is determined from the first events
+    if(global_config.get<bool>("performance_plots", false)) {
+        LOG(DEBUG) << "Creating histograms of the execution time per event";
+        for(auto& module : modules_) {
+            module->getROOTDirectory()->cd();
+            std::string title =
+                "Execution time per event of " + module->get_identifier().getUniqueName() + ";time [ms];events";
+            module_event_time_[module.get()] = new TH1D("execution_time", title.c_str(), 100, 0, 0);
+        }
+    }
+    if(global_config.get<bool>("hardware_counters", false)) {
+        counters_ = std::make_unique<HardwareCounters>();
+        if(counters_->isAvailable()) {
+            LOG(DEBUG) << "Reading hardware performance counters for all module instantiations";
+            for(auto& module : modules_) {
+                module_counters_[module.get()];
+            }
+        } else {
+            LOG(WARNING) << "Hardware performance counters are not available (" << counters_->getError()
+                         << "), continuing without them";
+            counters_.reset();
+        }
+    }
+    if(memory_accounting_) {
+        LOG(DEBUG) << "Creating histograms of the size of the dispatched messages per event";
+        for(auto& module : modules_) {
+            module->getROOTDirectory()->cd();
+            std::string title =
+                "Size of messages dispatched per event by " + module->get_identifier().getUniqueName() + ";size [kB];events";
+            module_message_size_[module.get()] = new TH1D("message_size", title.c_str(), 100, 0, 0);
+        }
+    }
+
     // Loop over all the events
     auto start_time = std::chrono::steady_clock::now();
     global_config.setDefault<unsigned int>("number_of_events", 1u);
     auto number_of_events = global_config.get<unsigned int>("number_of_events");
-    for(unsigned int i = 0; i < number_of_events; ++i) {
+
+    // Store checkpoints at the configured interval of events and resume from the last one if requested
+    auto checkpoint_interval = global_config.get<unsigned int>("checkpoint_interval", 0u);
+    auto resume = global_config.get<bool>("resume", false);
+    auto checkpoint_file = global_config.has("checkpoint_file") ? global_config.getPath("checkpoint_file", false)
+                                                                 : std::string(gSystem->pwd()) + "/checkpoint.txt";
+    if(checkpoint_interval > 0 || resume) {
+        for(auto& module : modules_) {
+            // Histograms are not part of the checkpoint and would only cover the events after resuming
+            auto& module_config = module->get_configuration();
+            if(module_config.get<bool>("output_plots", false)) {
+                throw InvalidValueError(module_config, "output_plots", "histograms cannot be stored in checkpoints");
+            }
+            if(!module->canCheckpoint()) {
+                LOG(WARNING) << "Module " << module->get_identifier().getUniqueName()
+                             << " does not support checkpoints, its results will differ from an uninterrupted run";
+            }
+        }
+    }
+    // Skip the first events if requested, the remaining events are numbered and seeded as in the full simulation
+    auto first_event = global_config.get<unsigned int>("skip_events", 0u);
+    if(first_event > number_of_events) {
+        throw InvalidValueError(global_config, "skip_events", "cannot skip more events than the number of events");
+    }
+    auto event_seeds = global_config.get<bool>("event_seeds", false);
+    if(first_event > 0 && !event_seeds) {
+        throw InvalidCombinationError(global_config,
+                                      {"skip_events", "event_seeds"},
+                                      "events can only be skipped if the random seeds are derived per event");
+    }
+    if(resume) {
+        first_event = read_checkpoint(checkpoint_file);
+        if(first_event > number_of_events) {
+            throw InvalidValueError(global_config,
+                                    "number_of_events",
+                                    "checkpoint has been written after event " + std::to_string(first_event) +
+                                        ", cannot resume a simulation with less events");
+        }
+        LOG(STATUS) << "Resuming simulation from checkpoint after event " << first_event;
+    }
+
+    for(unsigned int i = first_event; i < number_of_events; ++i) {
         // Check for termination
         if(terminate_) {
             LOG(INFO) << "Interrupting event loop after " << i << " events because of request to terminate";
             number_of_events = i;
             global_config.set<unsigned int>("number_of_events", i);
+            if(checkpoint_interval > 0) {
+                write_checkpoint(checkpoint_file, i);
+            }
             break;
         }
 
@@ -628,6 +919,11 @@ void ModuleManager::run() {
 
         // Get object count for linking objects in current event
         auto save_id = TProcessID::GetObjectCount();
+        auto event_start = std::chrono::steady_clock::now();
+
+        // Process all detectors again
+        skipped_detectors_.clear();
+        skip_event_ = false;
 
         std::string module_name;
         if(!modules_.empty()) {
@@ -640,18 +936,31 @@ void ModuleManager::run() {
                 thread_pool->execute_all();
             }
 
-            auto execute_module = [module = module.get(), event_num = i + 1, this, number_of_events]() {
+            auto execute_module = [module = module.get(), event_num = i + 1, this, number_of_events, event_seeds]() {
                 LOG_PROGRESS(TRACE, "EVENT_LOOP") << "Running event " << event_num << " of " << number_of_events << " ["
                                                   << module->get_identifier().getUniqueName() << "]";
+                // Check if the event or the detector of the module has been skipped
+                {
+                    std::lock_guard<std::mutex> lock(skip_mutex_);
+                    if(skip_event_ || (module->getDetector() != nullptr &&
+                                       skipped_detectors_.find(module->getDetector()) != skipped_detectors_.end())) {
+                        LOG(TRACE) << "Event has been skipped for " << module->get_identifier().getUniqueName();
+                        module_skipped_.at(module)++;
+                        return;
+                    }
+                }
                 // Check if module is satisfied to run
                 if(!module->check_delegates()) {
                     LOG(TRACE) << "Not all required messages are received for " << module->get_identifier().getUniqueName()
                                << ", skipping module!";
+                    module_skipped_.at(module)++;
                     return;
                 }
 
-                // Get current time
+                // Get current time and memory
                 auto start = std::chrono::steady_clock::now();
+                auto start_memory = (memory_accounting_ ? get_current_memory() : 0);
+                auto start_peak = (memory_accounting_ ? get_peak_memory() : 0);
                 // Set run module section header
                 std::string old_section_name = Log::getSection();
                 std::string section_name = "R:";
@@ -664,20 +973,53 @@ void ModuleManager::run() {
                     // DEPRECATED: Switching to the directory should be removed, but can break current modules
                     module->getROOTDirectory()->cd();
                 }
+                // Derive the random seeds of the module for this event if requested
+                if(event_seeds) {
+                    module->set_event_seed(event_num);
+                }
                 // Run module
+                HardwareCounters::Values start_counters;
+                if(counters_ != nullptr) {
+                    start_counters = counters_->read();
+                }
                 try {
                     module->run(event_num);
                 } catch(EndOfRunException& e) {
                     // Terminate if the module threw the EndOfRun request exception:
                     LOG(WARNING) << "Request to terminate:" << std::endl << e.what();
                     terminate_ = true;
+                } catch(SkipEventException& e) {
+                    // Skip the remaining modules of the detector, or of the event for unique modules
+                    std::lock_guard<std::mutex> lock(skip_mutex_);
+                    if(module->getDetector() != nullptr) {
+                        LOG(DEBUG) << "Request to skip the remaining modules of detector "
+                                   << module->getDetector()->getName() << ": " << e.what();
+                        skipped_detectors_.insert(module->getDetector());
+                    } else {
+                        LOG(DEBUG) << "Request to skip the remaining modules of the event: " << e.what();
+                        skip_event_ = true;
+                    }
+                }
+                if(counters_ != nullptr) {
+                    module_counters_.at(module) += counters_->read() - start_counters;
                 }
                 // Reset logging
                 Log::setSection(old_section_name);
                 set_module_after(old_settings);
                 // Update execution time
                 auto end = std::chrono::steady_clock::now();
-                module_execution_time_[module] += static_cast<std::chrono::duration<long double>>(end - start).count();
+                auto duration = static_cast<std::chrono::duration<long double>>(end - start).count();
+                module_execution_time_[module] += duration;
+                // Record the instrumentation if requested
+                if(!module_event_time_.empty()) {
+                    module_event_time_.at(module)->Fill(static_cast<double>(1000 * duration));
+                }
+                if(trace_ != nullptr) {
+                    trace_->addSpan(module->get_identifier().getUniqueName(), "run", start, end);
+                }
+                if(memory_accounting_) {
+                    record_memory_usage(module, &MemoryUsage::run, start_memory, start_peak);
+                }
             };
 
             if(module->canParallelize()) {
@@ -694,18 +1036,44 @@ void ModuleManager::run() {
         // Finish executing the last remaining tasks
         thread_pool->execute_all();
 
+        // Account the size of the messages dispatched in this event
+        if(memory_accounting_) {
+            auto message_sizes = messenger_->collectMessageSizes();
+            for(auto& module : modules_) {
+                auto size_iter = message_sizes.find(module.get());
+                uint64_t size = (size_iter != message_sizes.end() ? size_iter->second : 0);
+                auto& usage = module_memory_.at(module.get());
+                usage.messages += size;
+                usage.max_event_messages = std::max(usage.max_event_messages, size);
+                module_message_size_.at(module.get())->Fill(static_cast<double>(size) / 1e3);
+            }
+        }
+
         // Resetting delegates
         for(auto& module : modules_) {
             LOG(TRACE) << "Resetting messages";
             module->reset_delegates();
         }
 
+        // Rewind the memory of all messages of this event
+        messenger_->resetEventArena();
+
         // Reset object count for next event
         TProcessID::SetObjectCount(save_id);
+
+        if(trace_ != nullptr) {
+            trace_->addSpan("Event " + std::to_string(i + 1), "event", event_start, std::chrono::steady_clock::now());
+        }
+
+        // Store a checkpoint after every interval of events and after the last event
+        if(checkpoint_interval > 0 && ((i + 1) % checkpoint_interval == 0 || i + 1 == number_of_events)) {
+            write_checkpoint(checkpoint_file, i + 1);
+        }
     }
     LOG_PROGRESS(STATUS, "EVENT_LOOP") << "Finished run of " << number_of_events << " events";
     auto end_time = std::chrono::steady_clock::now();
-    total_time_ += static_cast<std::chrono::duration<long double>>(end_time - start_time).count();
+    run_time_ = static_cast<std::chrono::duration<long double>>(end_time - start_time).count();
+    total_time_ += run_time_;
 
     // Remove pool from modules, wait for the threads to finish and destroy pool
     LOG(TRACE) << "Destroying thread pool";
@@ -748,8 +1116,10 @@ void ModuleManager::finalize() {
     for(auto& module : modules_) {
         LOG_PROGRESS(TRACE, "FINALIZE_LOOP") << "Finalizing " << module->get_identifier().getUniqueName();
 
-        // Get current time
+        // Get current time and memory
         auto start = std::chrono::steady_clock::now();
+        auto start_memory = (memory_accounting_ ? get_current_memory() : 0);
+        auto start_peak = (memory_accounting_ ? get_peak_memory() : 0);
         // Set finalize module section header
         std::string old_section_name = Log::getSection();
         std::string section_name = "F:";
@@ -761,6 +1131,36 @@ void ModuleManager::finalize() {
         module->getROOTDirectory()->cd();
         // Finalize module
         module->finalize();
+        if(memory_accounting_) {
+            record_memory_usage(module.get(), &MemoryUsage::finalize, start_memory, start_peak);
+        }
+        // Write the histogram of the execution time per event
+        auto event_time = module_event_time_.find(module.get());
+        if(event_time != module_event_time_.end()) {
+            module->getROOTDirectory()->cd();
+            event_time->second->Write();
+        }
+        // Write the histograms of the memory usage
+        if(memory_accounting_) {
+            module->getROOTDirectory()->cd();
+            auto message_size = module_message_size_.find(module.get());
+            if(message_size != module_message_size_.end()) {
+                message_size->second->Write();
+            }
+
+            auto& usage = module_memory_.at(module.get());
+            std::string title = "Memory usage of " + module->get_identifier().getUniqueName() + ";;memory [MB]";
+            auto* memory_usage = new TH1D("memory_usage", title.c_str(), 4, 0, 4);
+            std::vector<std::pair<std::string, double>> stages{{"init", static_cast<double>(usage.init)},
+                                                               {"run", static_cast<double>(usage.run)},
+                                                               {"finalize", static_cast<double>(usage.finalize)},
+                                                               {"peak", static_cast<double>(usage.peak)}};
+            for(size_t bin = 0; bin < stages.size(); ++bin) {
+                memory_usage->GetXaxis()->SetBinLabel(static_cast<int>(bin + 1), stages[bin].first.c_str());
+                memory_usage->SetBinContent(static_cast<int>(bin + 1), stages[bin].second / 1e6);
+            }
+            memory_usage->Write();
+        }
         // Remove the pointer to the ROOT directory after finalizing
         module->set_ROOT_directory(nullptr);
         // Remove the config manager
@@ -771,9 +1171,14 @@ void ModuleManager::finalize() {
         // Update execution time
         auto end = std::chrono::steady_clock::now();
         module_execution_time_[module.get()] += static_cast<std::chrono::duration<long double>>(end - start).count();
+        if(trace_ != nullptr) {
+            trace_->addSpan(module->get_identifier().getUniqueName(), "finalize", start, end);
+        }
     }
-    // Close module ROOT file
+    // Close module ROOT file (deleting the histograms owned by it)
     modules_file_->Close();
+    module_event_time_.clear();
+    module_message_size_.clear();
     LOG_PROGRESS(STATUS, "FINALIZE_LOOP") << "Finalization completed";
     auto end_time = std::chrono::steady_clock::now();
     total_time_ += static_cast<std::chrono::duration<long double>>(end_time - start_time).count();
@@ -793,6 +1198,57 @@ void ModuleManager::finalize() {
         LOG(INFO) << " Module " << module->getUniqueName() << " took " << module_execution_time_[module.get()] << " seconds";
     }
 
+    // Summarize the work skipped because of event filters or missing messages
+    unsigned long total_skipped = 0;
+    for(auto& module_skipped : module_skipped_) {
+        total_skipped += module_skipped.second;
+    }
+    if(total_skipped > 0) {
+        LOG(STATUS) << "Skipped " << total_skipped
+                    << " executions of modules because of filtered events or missing messages";
+        for(auto& module : modules_) {
+            auto skipped = module_skipped_[module.get()];
+            if(skipped > 0) {
+                LOG(INFO) << " Module " << module->getUniqueName() << " skipped " << skipped << " events";
+            }
+        }
+    }
+
+    // Summarize the hardware performance counters of all instantiations
+    if(counters_ != nullptr) {
+        LOG(STATUS) << "Hardware performance counters of the event processing:";
+        for(auto& module : modules_) {
+            auto& values = module_counters_.at(module.get());
+            auto cycles = static_cast<double>(std::max<uint64_t>(values.cycles, 1));
+            auto instructions = static_cast<double>(std::max<uint64_t>(values.instructions, 1));
+            LOG(INFO) << " Module " << module->getUniqueName() << ": " << values.cycles << " cycles, " << values.instructions
+                      << " instructions, " << static_cast<double>(values.instructions) / cycles
+                      << " instructions per cycle, " << 1000 * static_cast<double>(values.cache_misses) / instructions
+                      << " cache misses and " << 1000 * static_cast<double>(values.branch_misses) / instructions
+                      << " branch misses per 1000 instructions";
+        }
+    }
+
+    // Summarize the memory usage of all instantiations
+    if(memory_accounting_) {
+        uint64_t largest_peak = 0;
+        std::string largest_module;
+        for(auto& module : modules_) {
+            auto& usage = module_memory_.at(module.get());
+            if(usage.peak >= largest_peak) {
+                largest_peak = usage.peak;
+                largest_module = module->getUniqueName();
+            }
+            LOG(INFO) << " Module " << module->getUniqueName() << " allocated " << usage.init / 1000 << " kB in init, "
+                      << usage.run / 1000 << " kB in run and " << usage.finalize / 1000
+                      << " kB in finalize, raising the peak by " << usage.peak / 1000 << " kB; dispatched "
+                      << usage.messages / 1000 << " kB of messages with at most " << usage.max_event_messages / 1000
+                      << " kB per event";
+        }
+        LOG(STATUS) << "Peak memory usage of " << get_peak_memory() / 1000000 << " MB, largest increase of "
+                    << largest_peak / 1000000 << " MB in instantiation " << largest_module;
+    }
+
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
     long double processing_time = 0;
     auto total_events = global_config.get<unsigned int>("number_of_events");
@@ -800,10 +1256,182 @@ void ModuleManager::finalize() {
         processing_time = std::round((1000 * total_time_) / total_events);
     }
 
+    // Write the trace of the thread activity
+    if(trace_ != nullptr) {
+        auto trace_path = std::string(gSystem->pwd()) + "/" + global_config.get<std::string>("trace_file");
+        trace_path = allpix::add_file_extension(trace_path, "json");
+        trace_->write(trace_path);
+        LOG(STATUS) << "Wrote trace of the thread activity to " << trace_path;
+        trace_.reset();
+    }
+
+    // Write the report of the performance
+    if(global_config.has("performance_report")) {
+        auto report_path = std::string(gSystem->pwd()) + "/" + global_config.get<std::string>("performance_report");
+        report_path = allpix::add_file_extension(report_path, "json");
+        write_performance_report(report_path);
+        LOG(STATUS) << "Wrote performance report to " << report_path;
+    }
+
     LOG(STATUS) << "Average processing time is \x1B[1m" << processing_time << " ms/event\x1B[0m, event generation at \x1B[1m"
                 << std::round(global_config.get<double>("number_of_events") / total_time_) << " Hz\x1B[0m";
 }
 
+/**
+ * @throws RuntimeError If the report cannot be written
+ *
+ * The report is written in JSON format. It contains the event rate of the event loop, the peak resident memory of the
+ * process and the execution time of every module instantiation together with its share of the total execution time. If
+ * the memory accounting is enabled, the memory used by every instantiation and the size of its messages are added, as
+ * are the hardware performance counters of the event processing if they are read.
+ */
+void ModuleManager::write_performance_report(const std::string& file_name) {
+    std::ofstream file(file_name);
+    if(!file.good()) {
+        throw RuntimeError("Cannot write performance report " + file_name);
+    }
+
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+    auto number_of_events = global_config.get<unsigned int>("number_of_events");
+    long double events_per_second = 0;
+    if(run_time_ > 0) {
+        events_per_second = number_of_events / run_time_;
+    }
+
+    file << "{\n";
+    file << "  \"number_of_events\": " << number_of_events << ",\n";
+    file << "  \"workers\": " << std::max(1u, get_number_of_workers()) << ",\n";
+    file << "  \"total_time\": " << total_time_ << ",\n";
+    file << "  \"run_time\": " << run_time_ << ",\n";
+    file << "  \"events_per_second\": " << events_per_second << ",\n";
+    file << "  \"peak_memory\": " << get_peak_memory() << ",\n";
+    file << "  \"modules\": {";
+    bool first = true;
+    for(auto& module : modules_) {
+        auto time = module_execution_time_[module.get()];
+        file << (first ? "" : ",") << "\n    \"" << module->getUniqueName() << "\": {\"time\": " << time
+             << ", \"share\": " << (total_time_ > 0 ? time / total_time_ : 0);
+        if(counters_ != nullptr) {
+            auto& values = module_counters_.at(module.get());
+            file << ", \"counters\": {\"cycles\": " << values.cycles << ", \"instructions\": " << values.instructions
+                 << ", \"cache_misses\": " << values.cache_misses << ", \"branch_misses\": " << values.branch_misses << "}";
+        }
+        if(memory_accounting_) {
+            auto& usage = module_memory_.at(module.get());
+            file << ", \"memory\": {\"init\": " << usage.init << ", \"run\": " << usage.run
+                 << ", \"finalize\": " << usage.finalize << ", \"peak\": " << usage.peak
+                 << ", \"messages\": " << usage.messages << ", \"max_event_messages\": " << usage.max_event_messages << "}";
+        }
+        file << "}";
+        first = false;
+    }
+    file << "\n  }\n}\n";
+}
+
+/**
+ * The checkpoint contains the number of finished events followed by a section for every module instantiation, consisting of
+ * its unique name and the length of its state in bytes. The state starts with the random number generator of the module
+ * base class, followed by the state written by \ref Module::saveState for modules which support checkpoints. The file is
+ * written to a temporary file first and only replaces the previous checkpoint when complete, such that an interruption
+ * while writing the checkpoint does not leave a corrupted checkpoint behind.
+ */
+void ModuleManager::write_checkpoint(const std::string& file_name, unsigned int events) {
+    auto temporary_file_name = file_name + ".tmp";
+    std::ofstream file(temporary_file_name, std::ios_base::out | std::ios_base::trunc);
+    file << "events " << events << '\n';
+    for(auto& module : modules_) {
+        std::ostringstream state;
+        state << module->random_generator_ << '\n';
+        if(module->canCheckpoint()) {
+            module->saveState(state);
+        }
+
+        auto data = state.str();
+        file << "module " << module->get_identifier().getUniqueName() << ' ' << data.size() << '\n' << data << '\n';
+    }
+    file.close();
+
+    if(!file.good() || std::rename(temporary_file_name.c_str(), file_name.c_str()) != 0) {
+        throw RuntimeError("Cannot write checkpoint to " + file_name);
+    }
+    LOG(DEBUG) << "Stored checkpoint after event " << events << " in " << file_name;
+}
+
+/**
+ * @throws InvalidValueError If the checkpoint cannot be read or does not match the current list of modules
+ */
+unsigned int ModuleManager::read_checkpoint(const std::string& file_name) {
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+
+    std::ifstream file(file_name);
+    if(!file.good()) {
+        throw InvalidValueError(global_config, "checkpoint_file", "cannot open checkpoint " + file_name + " to resume from");
+    }
+
+    std::string key;
+    unsigned int events = 0;
+    file >> key >> events;
+    if(key != "events" || file.fail()) {
+        throw InvalidValueError(global_config, "checkpoint_file", "checkpoint " + file_name + " is corrupted");
+    }
+
+    std::map<std::string, std::string> states;
+    while(file >> key) {
+        std::string name;
+        size_t size = 0;
+        file >> name >> size;
+        file.ignore();
+        std::string data(size, '\0');
+        file.read(&data[0], static_cast<std::streamsize>(size));
+        if(key != "module" || file.fail()) {
+            throw InvalidValueError(global_config, "checkpoint_file", "checkpoint " + file_name + " is corrupted");
+        }
+        states.emplace(std::move(name), std::move(data));
+    }
+
+    // The modules need to match exactly to reproduce the results of an uninterrupted run
+    if(states.size() != modules_.size()) {
+        throw InvalidValueError(
+            global_config, "checkpoint_file", "checkpoint has been written for a different set of module instantiations");
+    }
+    for(auto& module : modules_) {
+        auto unique_name = module->get_identifier().getUniqueName();
+        auto state_iter = states.find(unique_name);
+        if(state_iter == states.end()) {
+            throw InvalidValueError(
+                global_config, "checkpoint_file", "checkpoint does not contain the state of module " + unique_name);
+        }
+
+        LOG(TRACE) << "Restoring state of " << unique_name << " from checkpoint";
+        std::istringstream state(state_iter->second);
+        state >> module->random_generator_;
+        if(module->canCheckpoint()) {
+            module->loadState(state);
+        }
+        if(state.fail()) {
+            throw InvalidValueError(
+                global_config, "checkpoint_file", "state of module " + unique_name + " in checkpoint cannot be restored");
+        }
+    }
+    return events;
+}
+
+/**
+ * The resident memory is sampled for the whole process. If modules are executed concurrently, memory allocated by other
+ * modules in the meantime is thus attributed to all of them and the accounting is only approximate.
+ */
+void ModuleManager::record_memory_usage(Module* module,
+                                        long long MemoryUsage::*stage,
+                                        uint64_t start_memory,
+                                        uint64_t start_peak) {
+    auto& usage = module_memory_.at(module);
+    usage.*stage += static_cast<long long>(get_current_memory()) - static_cast<long long>(start_memory);
+    auto peak = get_peak_memory();
+    if(peak > start_peak) {
+        usage.peak += peak - start_peak;
+    }
+}
+
 /**
  * All modules in the event loop continue to finish the current event
  */
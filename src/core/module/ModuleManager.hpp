@@ -11,17 +11,25 @@
 #define ALLPIX_MODULE_MANAGER_H
 
 #include <atomic>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <random>
+#include <set>
 
 #include <TDirectory.h>
 #include <TFile.h>
 
+class TH1D;
+
+#include "HardwareCounters.hpp"
 #include "Module.hpp"
+#include "ModuleRegistry.hpp"
 #include "ThreadPool.hpp"
+#include "TraceRecorder.hpp"
 #include "core/config/Configuration.hpp"
 #include "core/utils/log.h"
 
@@ -103,29 +111,49 @@ namespace allpix {
         void terminate();
 
     private:
+        /**
+         * @brief Get the functions to instantiate a module, loading its library if necessary
+         * @param config Configuration of the module
+         * @return Factory of the module
+         */
+        ModuleFactory load_module_factory(const Configuration& config);
+
+        /**
+         * @brief Replace every module configuration with variants by one configuration per variant
+         * @param configs List of module configurations
+         * @throws InvalidValueError If the names of the variants are invalid
+         */
+        static void expand_variants(std::list<Configuration>& configs);
+
         /**
          * @brief Create unique modules
-         * @param library Void pointer to the loaded library
+         * @param module_generator Function instantiating the module
          * @param config Configuration of the module
          * @param messenger Pointer to the messenger
          * @param geo_manager Pointer to the geometry manager
          * @param seeder Seeder used to construct the PRNG of the modules
          * @return An unique module together with its identifier
          */
-        std::pair<ModuleIdentifier, Module*>
-        create_unique_modules(void*, Configuration&, Messenger*, GeometryManager*, std::mt19937_64& seeder);
+        std::pair<ModuleIdentifier, Module*> create_unique_modules(
+            ModuleFactory::UniqueGenerator, Configuration&, Messenger*, GeometryManager*, std::mt19937_64& seeder);
 
         /**
          * @brief Create detector modules
-         * @param library Void pointer to the loaded library
+         * @param module_generator Function instantiating the module
          * @param config Configuration of the module
          * @param messenger Pointer to the messenger
          * @param geo_manager Pointer to the geometry manager
          * @param seeder Seeder used to construct the PRNG of the modules
          * @return A list of all created detector modules and their identifiers
          */
-        std::vector<std::pair<ModuleIdentifier, Module*>>
-        create_detector_modules(void*, Configuration&, Messenger*, GeometryManager*, std::mt19937_64& seeder);
+        std::vector<std::pair<ModuleIdentifier, Module*>> create_detector_modules(
+            ModuleFactory::DetectorGenerator, Configuration&, Messenger*, GeometryManager*, std::mt19937_64& seeder);
+
+        /**
+         * @brief Get the number of workers to use from the global configuration
+         * @return Total number of workers or zero if multithreading is disabled
+         */
+        unsigned int get_number_of_workers();
 
         /**
          * @brief Set module specific log setting before running init/run/finalize
@@ -136,6 +164,51 @@ namespace allpix {
          */
         void set_module_after(std::tuple<LogLevel, LogFormat> prev);
 
+        /**
+         * @brief Write a machine-readable report of the performance of the simulation
+         * @param file_name Path of the file to write the report to
+         */
+        void write_performance_report(const std::string& file_name);
+
+        /**
+         * @brief Store the state of all modules after the given number of finished events in the checkpoint file
+         * @param file_name Path of the checkpoint file
+         * @param events Number of events finished so far
+         */
+        void write_checkpoint(const std::string& file_name, unsigned int events);
+
+        /**
+         * @brief Restore the state of all modules from the checkpoint file
+         * @param file_name Path of the checkpoint file
+         * @return Number of events finished before the checkpoint was written
+         */
+        unsigned int read_checkpoint(const std::string& file_name);
+
+        /**
+         * @brief Memory used by a module instantiation in the different stages of the simulation
+         *
+         * The stages contain the change of the resident memory of the process, the peak the increase of the peak resident
+         * memory of the process while executing the module. The messages contain the total and largest per-event memory
+         * size of the messages dispatched by the module.
+         */
+        struct MemoryUsage {
+            long long init{};
+            long long run{};
+            long long finalize{};
+            uint64_t peak{};
+            uint64_t messages{};
+            uint64_t max_event_messages{};
+        };
+
+        /**
+         * @brief Record the memory used by a module in one of the stages
+         * @param module Module to record the memory usage for
+         * @param stage Stage of the simulation the memory was used in
+         * @param start_memory Resident memory of the process before executing the module
+         * @param start_peak Peak resident memory of the process before executing the module
+         */
+        void record_memory_usage(Module* module, long long MemoryUsage::*stage, uint64_t start_memory, uint64_t start_peak);
+
         using ModuleList = std::list<std::unique_ptr<Module>>;
         using IdentifierToModuleMap = std::map<ModuleIdentifier, ModuleList::iterator>;
 
@@ -143,13 +216,35 @@ namespace allpix {
         IdentifierToModuleMap id_to_module_;
 
         ConfigManager* conf_manager_{};
+        Messenger* messenger_{};
 
         std::unique_ptr<TFile> modules_file_;
 
         std::map<Module*, long double> module_execution_time_;
         long double total_time_{};
+        long double run_time_{};
+
+        // Optional instrumentation: histograms of the execution time per event and trace of the thread activity
+        std::map<Module*, TH1D*> module_event_time_;
+        std::unique_ptr<TraceRecorder> trace_;
+
+        // Optional memory accounting per module instantiation
+        bool memory_accounting_{};
+        std::map<Module*, MemoryUsage> module_memory_;
+        std::map<Module*, TH1D*> module_message_size_;
+
+        // Optional hardware performance counters of the event processing per module instantiation
+        std::unique_ptr<HardwareCounters> counters_;
+        std::map<Module*, HardwareCounters::Values> module_counters_;
+
+        // Number of events every module has been skipped for, and the detectors skipped in the current event
+        std::map<Module*, unsigned long> module_skipped_;
+        std::set<std::shared_ptr<Detector>> skipped_detectors_;
+        bool skip_event_{};
+        std::mutex skip_mutex_;
 
         std::map<std::string, void*> loaded_libraries_;
+        ModuleRegistry static_modules_;
 
         std::atomic<bool> terminate_;
     };
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @brief Registry of the modules linked statically into the executable
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_MODULE_REGISTRY_H
+#define ALLPIX_MODULE_REGISTRY_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace allpix {
+
+    class Configuration;
+    class Detector;
+    class GeometryManager;
+    class Messenger;
+    class Module;
+
+    /**
+     * @brief Functions to instantiate a module, either from a dynamically loaded library or linked into the executable
+     *
+     * Depending on the type of the module, only the generator of unique modules or of detector modules is set.
+     */
+    struct ModuleFactory {
+        using UniqueGenerator = Module* (*)(Configuration&, Messenger*, GeometryManager*);
+        using DetectorGenerator = Module* (*)(Configuration&, Messenger*, std::shared_ptr<Detector>);
+
+        bool unique{};
+        UniqueGenerator unique_generator{};
+        DetectorGenerator detector_generator{};
+    };
+
+    /**
+     * @brief Registry of the factories of all modules linked statically into the executable
+     *
+     * The registry is filled by \ref register_static_modules, which is generated by the build system from the list of
+     * enabled modules if the executable is built with the BUILD_STATIC_EXECUTABLE option.
+     */
+    class ModuleRegistry {
+    public:
+        /**
+         * @brief Add the factory of a module
+         * @param name Name of the module as used in the configuration
+         * @param factory Functions to instantiate the module
+         */
+        void add(std::string name, ModuleFactory factory) { factories_.emplace(std::move(name), factory); }
+
+        /**
+         * @brief Find the factory of a module
+         * @param name Name of the module as used in the configuration
+         * @return Pointer to the factory or a null pointer if the module is not registered
+         */
+        const ModuleFactory* find(const std::string& name) const {
+            auto iter = factories_.find(name);
+            return (iter != factories_.end() ? &iter->second : nullptr);
+        }
+
+    private:
+        std::map<std::string, ModuleFactory> factories_;
+    };
+
+    /**
+     * @brief Register all modules linked statically into the executable
+     * @param registry Registry to add the modules to
+     * @note Only defined by the build system for executables built with the BUILD_STATIC_EXECUTABLE option
+     */
+    void register_static_modules(ModuleRegistry& registry);
+} // namespace allpix
+
+#endif /* ALLPIX_MODULE_REGISTRY_H */
@@ -19,7 +19,9 @@ using namespace allpix;
  */
 ThreadPool::ThreadPool(unsigned int num_threads,
                        const std::vector<Module*>& modules,
-                       const std::function<void()>& worker_init_function) {
+                       const std::function<void()>& worker_init_function,
+                       TraceRecorder* trace)
+    : trace_(trace) {
     // Create threads
     try {
         for(unsigned int i = 0u; i < num_threads; ++i) {
@@ -97,8 +99,12 @@ bool ThreadPool::execute_all() {
         }
 
         // Wait for the threads to complete their task, continue helping if a new task was pushed
+        auto wait_start = TraceRecorder::Clock::now();
         std::unique_lock<std::mutex> lock{run_mutex_};
         run_condition_.wait(lock, [this]() { return !all_queue_.empty() || run_cnt_ == 0; });
+        if(trace_ != nullptr) {
+            trace_->addSpan("Waiting for workers", "threadpool", wait_start, TraceRecorder::Clock::now());
+        }
 
         // Only stop when both the queue is empty and the run count is zero
         if(all_queue_.empty() && run_cnt_ == 0) {
@@ -129,7 +135,11 @@ void ThreadPool::worker(const std::function<void()>& init_function) {
     // Continue running until the thread pool is finished
     while(!done_) {
         SafeQueue<Task>* queue_ptr;
+        auto wait_start = TraceRecorder::Clock::now();
         if(all_queue_.pop(queue_ptr, true, increase_run_cnt_func)) {
+            if(trace_ != nullptr) {
+                trace_->addSpan("Waiting for task", "threadpool", wait_start, TraceRecorder::Clock::now());
+            }
             Task task{nullptr};
             if(queue_ptr->pop(task, false)) {
                 // Try to run task
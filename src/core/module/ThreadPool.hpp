@@ -27,6 +27,8 @@
 
 #include <iostream>
 
+#include "TraceRecorder.hpp"
+
 namespace allpix {
     class Module;
 
@@ -96,11 +98,13 @@ namespace allpix {
          * @param num_threads Number of threads in the pool
          * @param modules List of module instantiations to create a task queue for
          * @param worker_init_function Function run by all the workers to initialize
+         * @param trace Optional recorder to register the time threads spend waiting for work
          * @warning Only module instantiations that are registered in this constructor can spawn tasks
          */
         explicit ThreadPool(unsigned int num_threads,
                             const std::vector<Module*>& modules,
-                            const std::function<void()>& worker_init_function);
+                            const std::function<void()>& worker_init_function,
+                            TraceRecorder* trace = nullptr);
 
         /// @{
         /**
@@ -173,6 +177,8 @@ namespace allpix {
 
         std::atomic_flag has_exception_;
         std::exception_ptr exception_ptr_{nullptr};
+
+        TraceRecorder* trace_{nullptr};
     };
 } // namespace allpix
 
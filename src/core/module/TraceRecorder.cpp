@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @brief Implementation of the recorder of thread activity
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "TraceRecorder.hpp"
+
+#include <fstream>
+#include <utility>
+
+#include "core/utils/exceptions.h"
+
+using namespace allpix;
+
+TraceRecorder::TraceRecorder() : origin_(Clock::now()) {
+    // Register the constructing thread as the main thread
+    get_thread_index();
+}
+
+void TraceRecorder::addSpan(std::string name, std::string category, Clock::time_point start, Clock::time_point end) {
+    auto start_us = std::chrono::duration_cast<std::chrono::microseconds>(start - origin_).count();
+    auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_.push_back({std::move(name), std::move(category), start_us, duration_us, get_thread_index()});
+}
+
+unsigned int TraceRecorder::get_thread_index() {
+    auto id = std::this_thread::get_id();
+    auto iter = thread_indices_.find(id);
+    if(iter != thread_indices_.end()) {
+        return iter->second;
+    }
+    auto index = static_cast<unsigned int>(thread_indices_.size());
+    thread_indices_.emplace(id, index);
+    return index;
+}
+
+// Escape a string for use in JSON
+static std::string escape_json(const std::string& str) {
+    std::string out;
+    for(auto chr : str) {
+        if(chr == '"' || chr == '\\') {
+            out += '\\';
+        }
+        out += chr;
+    }
+    return out;
+}
+
+/**
+ * @throws RuntimeError If the trace file cannot be written
+ *
+ * All spans are written as complete events, the threads are named using metadata events.
+ */
+void TraceRecorder::write(const std::string& file_name) const {
+    std::ofstream file(file_name);
+    if(!file.good()) {
+        throw RuntimeError("Cannot write trace file " + file_name);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for(unsigned int thread = 0; thread < thread_indices_.size(); ++thread) {
+        file << (thread == 0 ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+             << ",\"args\":{\"name\":\"" << (thread == 0 ? std::string("Main thread") : "Worker " + std::to_string(thread))
+             << "\"}}";
+    }
+    for(auto& span : spans_) {
+        file << ",\n{\"name\":\"" << escape_json(span.name) << "\",\"cat\":\"" << escape_json(span.category)
+             << "\",\"ph\":\"X\",\"ts\":" << span.start << ",\"dur\":" << span.duration
+             << ",\"pid\":1,\"tid\":" << span.thread << "}";
+    }
+    file << "\n]}\n";
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief Recorder of the activity of all threads for performance analysis
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_TRACE_RECORDER_H
+#define ALLPIX_TRACE_RECORDER_H
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace allpix {
+    /**
+     * @brief Records time spans of the activity of all threads
+     *
+     * The spans are exported in the Chrome trace event format, which can be inspected with the tracing view of the Chrome
+     * browser or with Perfetto. The thread constructing the recorder is registered as the main thread, all other threads
+     * are registered as workers when they add their first span.
+     */
+    class TraceRecorder {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Construct the recorder, using the current time as origin of the trace
+         */
+        TraceRecorder();
+
+        /**
+         * @brief Add a span of activity of the calling thread
+         * @param name Name of the span
+         * @param category Category of the span
+         * @param start Start time of the span
+         * @param end End time of the span
+         */
+        void addSpan(std::string name, std::string category, Clock::time_point start, Clock::time_point end);
+
+        /**
+         * @brief Write all recorded spans to a file
+         * @param file_name Path of the file to write the trace to
+         */
+        void write(const std::string& file_name) const;
+
+    private:
+        struct Span {
+            std::string name;
+            std::string category;
+            long long start;
+            long long duration;
+            unsigned int thread;
+        };
+
+        /**
+         * @brief Get the index of the calling thread in the trace
+         * @return Index of the thread
+         * @warning The mutex should be locked by the caller
+         */
+        unsigned int get_thread_index();
+
+        Clock::time_point origin_;
+        std::vector<Span> spans_;
+        std::map<std::thread::id, unsigned int> thread_indices_;
+
+        mutable std::mutex mutex_;
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_TRACE_RECORDER_H */
@@ -121,6 +121,23 @@ namespace allpix {
         // TODO [doc] the module itself is missing
         explicit EndOfRunException(std::string reason) { error_message_ = std::move(reason); }
     };
+
+    /**
+     * @ingroup Exceptions
+     * @brief Exception for modules to request skipping the remaining modules in the current event
+     * @note Non-fatal error used to filter events without interesting data.
+     *
+     * If raised by a detector module, only the remaining modules of the same detector are skipped for this event. If raised
+     * by a unique module, all remaining modules are skipped and the next event is processed.
+     */
+    class SkipEventException : public RuntimeError {
+    public:
+        /**
+         * @brief Constructs request to skip the remaining modules with a description
+         * @param reason Text explaining the reason of the requested skip
+         */
+        explicit SkipEventException(std::string reason) { error_message_ = std::move(reason); }
+    };
 } // namespace allpix
 
 #endif /* ALLPIX_MODULE_EXCEPTIONS_H */
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @brief Special file automatically included in the modules for linking them statically into the executable
+ *
+ * Needs the following names to be defined by the build system
+ * - ALLPIX_MODULE_NAME: name of the module
+ * - ALLPIX_MODULE_HEADER: name of the header defining the module
+ * - ALLPIX_MODULE_UNIQUE: true if the module is unique, false otherwise
+ * - ALLPIX_MODULE_FACTORY: name of the function returning the factory of the module
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_MODULE_FACTORY
+#error "This header should only be automatically included during the build"
+#endif
+
+#include <memory>
+#include <utility>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/Detector.hpp"
+#include "core/module/ModuleRegistry.hpp"
+#include "core/utils/log.h"
+
+#include ALLPIX_MODULE_HEADER
+
+namespace allpix {
+    class Messenger;
+    class GeometryManager;
+
+    namespace {
+#if ALLPIX_MODULE_UNIQUE
+        // Instantiates the unique module
+        Module* generator(Configuration& config, Messenger* messenger, GeometryManager* geo_manager) {
+            return new ALLPIX_MODULE_NAME(config, messenger, geo_manager); // NOLINT
+        }
+#else
+        // Instantiates the detector module
+        Module* generator(Configuration& config, Messenger* messenger, std::shared_ptr<Detector> detector) {
+            return new ALLPIX_MODULE_NAME(config, messenger, std::move(detector)); // NOLINT
+        }
+#endif
+    } // namespace
+
+    /**
+     * @brief Returns the factory of the module this file is linked to
+     *
+     * Called from the \ref register_static_modules function generated by the build system. The function is named uniquely
+     * for every module, the generator functions are local to this file, such that all modules can be linked together.
+     */
+    ModuleFactory ALLPIX_MODULE_FACTORY();
+    ModuleFactory ALLPIX_MODULE_FACTORY() {
+        ModuleFactory factory;
+#if ALLPIX_MODULE_UNIQUE
+        factory.unique = true;
+        factory.unique_generator = generator;
+#else
+        factory.unique = false;
+        factory.detector_generator = generator;
+#endif
+        return factory;
+    }
+} // namespace allpix
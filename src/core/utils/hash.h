@@ -0,0 +1,41 @@
+/**
+ * @file
+ * @brief Utilities to calculate hashes which are stable between runs
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_HASH_H
+#define ALLPIX_HASH_H
+
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace allpix {
+
+    /**
+     * @brief Calculate a hash of a string
+     * @param str String to calculate the hash of
+     * @return Hash of the string as hexadecimal number with 16 digits
+     *
+     * Uses the 64-bit FNV-1a algorithm. In contrast to std::hash the result does not depend on the platform or the standard
+     * library, such that it can be used to identify data stored on disk between different runs of the framework.
+     */
+    inline std::string stable_hash(const std::string& str) {
+        uint64_t hash = 14695981039346656037ull;
+        for(auto chr : str) {
+            hash ^= static_cast<unsigned char>(chr);
+            hash *= 1099511628211ull;
+        }
+
+        std::ostringstream stream;
+        stream << std::hex << std::setw(16) << std::setfill('0') << hash;
+        return stream.str();
+    }
+} // namespace allpix
+
+#endif /* ALLPIX_HASH_H */
@@ -12,15 +12,21 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <exception>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <ostream>
 #include <regex>
 #include <string>
 #include <thread>
 #include <unistd.h>
+#include <vector>
 
 using namespace allpix;
 
@@ -31,6 +37,296 @@ std::string DefaultLogger::last_message_;
 // Mutex to guard output writing
 std::mutex DefaultLogger::write_mutex_;
 
+namespace allpix {
+    /**
+     * @brief Background writer for the asynchronous logging mode
+     *
+     * Every thread logging a message owns a single-producer single-consumer ring buffer, so appending a message does not
+     * require any lock shared between the threads. All messages carry a ticket from a global sequence, and the writer only
+     * writes a message once all messages with lower tickets have been written, which preserves the order in which they were
+     * logged across all threads and batches. Closing the backend sets a flag in the sequence, such that the number of
+     * messages to write before stopping is known exactly. Messages logged afterwards are written synchronously.
+     */
+    class AsyncLogBackend {
+    public:
+        /**
+         * @brief Formatted log message waiting to be written
+         */
+        struct Record {
+            uint64_t sequence{};
+            std::string message;
+            std::string identifier;
+        };
+
+        /**
+         * @brief Lock-free ring buffer of records filled by a single thread
+         */
+        class RingBuffer {
+        public:
+            // Move record into the buffer, returns false if the buffer is full
+            bool push(Record& record) {
+                auto head = head_.load(std::memory_order_relaxed);
+                auto next = (head + 1) % records_.size();
+                if(next == tail_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                records_[head] = std::move(record);
+                head_.store(next, std::memory_order_release);
+                return true;
+            }
+            // Move the oldest record out of the buffer, returns false if the buffer is empty
+            bool pop(Record& record) {
+                auto tail = tail_.load(std::memory_order_relaxed);
+                if(tail == head_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                record = std::move(records_[tail]);
+                tail_.store((tail + 1) % records_.size(), std::memory_order_release);
+                return true;
+            }
+            // Number of records currently in the buffer
+            size_t size() const {
+                auto head = head_.load(std::memory_order_acquire);
+                auto tail = tail_.load(std::memory_order_acquire);
+                return (head + records_.size() - tail) % records_.size();
+            }
+            size_t capacity() const { return records_.size() - 1; }
+
+            // Set when the owning thread exited
+            std::atomic_bool finished{false};
+
+        private:
+            std::array<Record, 1024> records_;
+            std::atomic<size_t> head_{0};
+            std::atomic<size_t> tail_{0};
+        };
+
+        /**
+         * @brief Get the single instance of the backend
+         */
+        static AsyncLogBackend& get() {
+            static AsyncLogBackend backend;
+            return backend;
+        }
+
+        AsyncLogBackend() = default;
+        ~AsyncLogBackend() { stop(); }
+
+        AsyncLogBackend(const AsyncLogBackend&) = delete;
+        AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+        AsyncLogBackend(AsyncLogBackend&&) = delete;
+        AsyncLogBackend& operator=(AsyncLogBackend&&) = delete;
+
+        bool running() const { return running_; }
+
+        // Start the background thread if not yet running, the sequence continues after the last written message
+        void start() {
+            std::lock_guard<std::mutex> control_lock(control_mutex_);
+            if(running_) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+                std::lock_guard<std::mutex> lock(closed_mutex_);
+                writer_done_ = false;
+                sequence_ = next_sequence_;
+            }
+            closed_condition_.notify_all();
+            thread_ = std::thread(&AsyncLogBackend::loop, this);
+            running_ = true;
+        }
+
+        // Close the sequence and wait until the background thread has written all messages logged before
+        void stop() {
+            std::lock_guard<std::mutex> control_lock(control_mutex_);
+            if(!running_) {
+                return;
+            }
+            sequence_.fetch_or(closed_flag_);
+            wake();
+            thread_.join();
+            running_ = false;
+        }
+
+        /**
+         * Appends the message to the buffer of the calling thread. If the buffer is full the caller waits until the
+         * background thread made space, no message is ever dropped. Returns false if the backend has been closed, the
+         * caller should then write the message directly. This only happens after all messages logged before closing have
+         * been written.
+         */
+        bool push(std::string& message, const std::string& identifier) {
+            auto ticket = sequence_++;
+            if((ticket & closed_flag_) != 0) {
+                wait_closed();
+                return false;
+            }
+
+            Record record{ticket, std::move(message), identifier};
+            auto& buffer = local_buffer();
+            while(!buffer.push(record)) {
+                wake();
+                std::unique_lock<std::mutex> lock(space_mutex_);
+                space_condition_.wait_for(
+                    lock, std::chrono::milliseconds(10), [&buffer]() { return buffer.size() < buffer.capacity(); });
+            }
+
+            // Wake up the writer early if the buffer fills up or a process line should be updated
+            if(!identifier.empty() || buffer.size() > buffer.capacity() / 2) {
+                wake();
+            }
+            return true;
+        }
+
+        /**
+         * Collects the pending records of all threads and writes all records whose predecessors have been written as a
+         * single batch. Records following a message which has not yet been appended to its buffer are kept for the next
+         * batch. Buffers of threads that exited are removed once they are empty. Returns the number of written records.
+         */
+        uint64_t drain() {
+            std::lock_guard<std::mutex> drain_lock(drain_mutex_);
+
+            {
+                std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+                for(auto iter = buffers_.begin(); iter != buffers_.end();) {
+                    bool finished = (*iter)->finished;
+                    Record record;
+                    while((*iter)->pop(record)) {
+                        auto sequence = record.sequence;
+                        pending_.emplace(sequence, std::move(record));
+                    }
+                    if(finished) {
+                        iter = buffers_.erase(iter);
+                    } else {
+                        ++iter;
+                    }
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(space_mutex_);
+            }
+            space_condition_.notify_all();
+
+            if(pending_.empty() || pending_.begin()->first != next_sequence_) {
+                return next_sequence_;
+            }
+
+            std::lock_guard<std::mutex> write_lock(DefaultLogger::write_mutex_);
+            while(!pending_.empty() && pending_.begin()->first == next_sequence_) {
+                auto& record = pending_.begin()->second;
+                DefaultLogger::write_message(std::move(record.message), record.identifier);
+                pending_.erase(pending_.begin());
+                ++next_sequence_;
+            }
+            DefaultLogger::flush_streams();
+            return next_sequence_;
+        }
+
+        // Write all messages logged before calling this method, once closed wait for the background thread to write them
+        void flush() {
+            auto sequence = sequence_.load();
+            if((sequence & closed_flag_) != 0) {
+                wait_closed();
+                return;
+            }
+            while(drain() < sequence) {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        // Ring buffer of the calling thread, registered on first use
+        RingBuffer& local_buffer() {
+            struct BufferHolder {
+                std::shared_ptr<RingBuffer> buffer;
+                BufferHolder() = default;
+                BufferHolder(const BufferHolder&) = delete;
+                BufferHolder& operator=(const BufferHolder&) = delete;
+                BufferHolder(BufferHolder&&) = delete;
+                BufferHolder& operator=(BufferHolder&&) = delete;
+                ~BufferHolder() {
+                    if(buffer != nullptr) {
+                        buffer->finished = true;
+                    }
+                }
+            };
+            thread_local BufferHolder holder;
+
+            if(holder.buffer == nullptr) {
+                holder.buffer = std::make_shared<RingBuffer>();
+                std::lock_guard<std::mutex> lock(buffers_mutex_);
+                buffers_.push_back(holder.buffer);
+            }
+            return *holder.buffer;
+        }
+
+        // Wait until the background thread has written all messages logged before closing, or the backend is restarted
+        void wait_closed() {
+            std::unique_lock<std::mutex> lock(closed_mutex_);
+            closed_condition_.wait(lock, [this]() { return writer_done_ || (sequence_ & closed_flag_) == 0; });
+        }
+
+        // Wake up the background thread, a missed notification only delays the batch until the next timeout
+        void wake() {
+            wake_ = true;
+            wake_condition_.notify_one();
+        }
+
+        // Main loop of the background thread, writing batches until all messages logged before closing are written
+        void loop() {
+            while(true) {
+                {
+                    std::unique_lock<std::mutex> lock(wake_mutex_);
+                    wake_condition_.wait_for(lock, std::chrono::milliseconds(50), [this]() { return wake_.load(); });
+                    wake_ = false;
+                }
+                auto written = drain();
+
+                auto sequence = sequence_.load();
+                if((sequence & closed_flag_) != 0) {
+                    if(written == (sequence & ~closed_flag_)) {
+                        break;
+                    }
+                    // Messages logged before closing are still being appended, continue without waiting
+                    wake_ = true;
+                    std::this_thread::yield();
+                }
+            }
+
+            // Let all waiting and later messages be written directly by their thread
+            {
+                std::lock_guard<std::mutex> lock(closed_mutex_);
+                writer_done_ = true;
+            }
+            closed_condition_.notify_all();
+        }
+
+        static constexpr uint64_t closed_flag_ = uint64_t(1) << 63;
+
+        std::vector<std::shared_ptr<RingBuffer>> buffers_;
+        std::mutex buffers_mutex_;
+
+        std::atomic<uint64_t> sequence_{0};
+        uint64_t next_sequence_{0};
+        std::map<uint64_t, Record> pending_;
+        std::mutex drain_mutex_;
+
+        std::mutex space_mutex_;
+        std::condition_variable space_condition_;
+
+        std::atomic_bool wake_{false};
+        std::mutex wake_mutex_;
+        std::condition_variable wake_condition_;
+
+        bool writer_done_{false};
+        std::mutex closed_mutex_;
+        std::condition_variable closed_condition_;
+
+        std::thread thread_;
+        std::atomic_bool running_{false};
+        std::mutex control_mutex_;
+    };
+} // namespace allpix
+
 /**
  * The logger will save the number of uncaught exceptions during construction to compare that with the number of exceptions
  * during destruction later.
@@ -64,12 +360,28 @@ DefaultLogger::~DefaultLogger() {
         } while((start_pos = out.find('\n', start_pos)) != std::string::npos);
     }
 
+    // Pass the message to the background writer, fatal messages are written directly after all pending ones
+    auto& backend = AsyncLogBackend::get();
+    if(backend.running()) {
+        if(level_ != LogLevel::FATAL && backend.push(out, identifier_)) {
+            return;
+        }
+        backend.flush();
+    }
+
     // Lock the mutex to guard last identifier usage
-    std::unique_lock<std::mutex> lock(write_mutex_);
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    write_message(std::move(out), identifier_);
+    flush_streams();
+}
 
+/**
+ * Adds the terminal control characters to update process logs and strips them for streams which are not a terminal.
+ */
+void DefaultLogger::write_message(std::string out, const std::string& identifier) {
     // Add extra spaces if necessary
     size_t extra_spaces = 0;
-    if(!identifier_.empty() && last_identifier_ == identifier_) {
+    if(!identifier.empty() && last_identifier_ == identifier) {
         // Put carriage return for process logs
         out = '\r' + out;
 
@@ -81,7 +393,7 @@ DefaultLogger::~DefaultLogger() {
         // End process log and continue normal logging
         out = '\n' + out;
     }
-    last_identifier_ = identifier_;
+    last_identifier_ = identifier;
 
     // Save last message
     last_message_ = out;
@@ -93,7 +405,7 @@ DefaultLogger::~DefaultLogger() {
     }
 
     // Add final newline if not a progress log
-    if(identifier_.empty()) {
+    if(identifier.empty()) {
         out += '\n';
     }
 
@@ -122,9 +434,13 @@ DefaultLogger::~DefaultLogger() {
         } else {
             (*stream) << out_no_special;
         }
+    }
+}
+
+void DefaultLogger::flush_streams() {
+    for(auto stream : get_streams()) {
         (*stream).flush();
     }
-    lock.unlock();
 }
 
 /**
@@ -132,6 +448,9 @@ DefaultLogger::~DefaultLogger() {
  * @note Does not close the streams
  */
 void DefaultLogger::finish() {
+    // Write all pending messages and stop the background writer
+    AsyncLogBackend::get().stop();
+
     // Lock the mutex to guard output writing
     std::lock_guard<std::mutex> lock(write_mutex_);
 
@@ -163,6 +482,8 @@ void DefaultLogger::finish() {
  */
 std::ostringstream&
 DefaultLogger::getStream(LogLevel level, const std::string& file, const std::string& function, uint32_t line) {
+    level_ = level;
+
     // Add date in all except short format
     if(get_format() != LogFormat::SHORT) {
         os << "\x1B[1m"; // BOLD
@@ -354,6 +675,25 @@ void DefaultLogger::addStream(std::ostream& stream) {
     get_streams().push_back(&stream);
 }
 
+/**
+ * Pending messages are written before switching back to direct writing.
+ */
+void DefaultLogger::setAsynchronous(bool asynchronous) {
+    if(asynchronous) {
+        AsyncLogBackend::get().start();
+    } else {
+        AsyncLogBackend::get().stop();
+    }
+}
+bool DefaultLogger::isAsynchronous() {
+    return AsyncLogBackend::get().running();
+}
+void DefaultLogger::flush() {
+    if(AsyncLogBackend::get().running()) {
+        AsyncLogBackend::get().flush();
+    }
+}
+
 // Getters and setters for the section header
 std::string& DefaultLogger::get_section() {
     thread_local std::string section;
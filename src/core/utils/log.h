@@ -52,6 +52,8 @@ namespace allpix {
      */
     // TODO [DOC] This just be renamed to Log?
     class DefaultLogger {
+        friend class AsyncLogBackend;
+
     public:
         /**
          * @brief Construct a logger
@@ -174,6 +176,26 @@ namespace allpix {
          */
         static const std::vector<std::ostream*>& getStreams();
 
+        /**
+         * @brief Enable or disable asynchronous writing of the log messages
+         * @param asynchronous True if messages should be written by a background thread, false to write them directly
+         *
+         * In asynchronous mode every thread appends its formatted messages to its own bounded buffer without locking, and a
+         * background thread drains the buffers of all threads, writing the messages in batches and flushing the streams
+         * only once per batch. The messages keep the order in which they were logged. Fatal messages and messages logged
+         * after the background thread has been stopped are written directly after all pending messages.
+         */
+        static void setAsynchronous(bool asynchronous);
+        /**
+         * @brief Return if the log messages are written asynchronously
+         * @return True if asynchronous writing is enabled, false otherwise
+         */
+        static bool isAsynchronous();
+        /**
+         * @brief Write all pending asynchronous log messages to the streams
+         */
+        static void flush();
+
         /**
          * @brief Set the section header to use from now on
          * @param header Header to use
@@ -204,6 +226,19 @@ namespace allpix {
          */
         static bool is_terminal(std::ostream& stream);
 
+        /**
+         * @brief Write a formatted message to all streams without flushing them
+         * @param out Formatted message
+         * @param identifier Identifier of the process log or empty if a normal log message
+         * @warning The write mutex should be locked by the caller
+         */
+        static void write_message(std::string out, const std::string& identifier);
+        /**
+         * @brief Flush all streams
+         * @warning The write mutex should be locked by the caller
+         */
+        static void flush_streams();
+
         // Output stream
         std::ostringstream os;
 
@@ -211,6 +246,8 @@ namespace allpix {
         int exception_count_{};
         // Saved value of the length of the header indent
         unsigned int indent_count_{};
+        // Level of the message
+        LogLevel level_{LogLevel::NONE};
 
         // Internal methods to store static values
         static std::string& get_section();
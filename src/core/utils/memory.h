@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @brief Utilities to query the memory usage of the process
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_MEMORY_H
+#define ALLPIX_MEMORY_H
+
+#include <cstdint>
+#include <fstream>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+namespace allpix {
+
+    /**
+     * @brief Get the current resident set size of the process
+     * @return Amount of physical memory currently used by the process in bytes, or zero if it cannot be determined
+     */
+    inline uint64_t get_current_memory() {
+#ifdef __APPLE__
+        mach_task_basic_info info{};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+            return 0;
+        }
+        return static_cast<uint64_t>(info.resident_size);
+#else
+        // The second field contains the number of resident pages
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0, resident = 0;
+        if(!(statm >> size >> resident)) {
+            return 0;
+        }
+        return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    /**
+     * @brief Get the peak resident set size of the process
+     * @return Largest amount of physical memory used by the process so far in bytes, or zero if it cannot be determined
+     */
+    inline uint64_t get_peak_memory() {
+        struct rusage usage {};
+        if(getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+#ifdef __APPLE__
+        // Reported in bytes on Mac OS X
+        return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+        // Reported in kilobytes on Linux
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+} // namespace allpix
+
+#endif /* ALLPIX_MEMORY_H */
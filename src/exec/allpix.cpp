@@ -17,11 +17,13 @@
 #include <utility>
 
 #include "core/Allpix.hpp"
+#include "core/JobSplitter.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "core/geometry/GeometryManager.hpp"
 #include "core/utils/exceptions.h"
 
 #include "core/utils/log.h"
+#include "core/utils/text.h"
 
 using namespace allpix;
 
@@ -31,6 +33,8 @@ void interrupt_handler(int);
 
 std::unique_ptr<Allpix> apx;
 std::atomic<bool> apx_ready{false};
+std::unique_ptr<JobSplitter> splitter;
+std::atomic<bool> splitter_ready{false};
 
 /**
  * @brief Handle user abort (CTRL+\) which should stop the framework immediately
@@ -55,6 +59,11 @@ void interrupt_handler(int) {
         LOG(STATUS) << "Interrupted! Finishing up current event...";
         apx->terminate();
     }
+    // Forward the request to the worker processes if the simulation is split
+    if(splitter_ready) {
+        LOG(STATUS) << "Interrupted! Finishing up current event of all workers...";
+        splitter->terminate();
+    }
 }
 
 /**
@@ -65,6 +74,9 @@ void clean() {
     if(apx_ready) {
         apx.reset();
     }
+    if(splitter_ready) {
+        splitter.reset();
+    }
 }
 
 /**
@@ -96,6 +108,7 @@ int main(int argc, const char* argv[]) {
     std::string log_file_name;
     std::vector<std::string> module_options;
     std::vector<std::string> detector_options;
+    unsigned int workers = 1;
     for(int i = 1; i < argc; i++) {
         if(strcmp(argv[i], "-h") == 0) {
             print_help = true;
@@ -125,6 +138,15 @@ int main(int argc, const char* argv[]) {
             module_options.emplace_back(std::string(argv[++i]));
         } else if(strcmp(argv[i], "-g") == 0 && (i + 1 < argc)) {
             detector_options.emplace_back(std::string(argv[++i]));
+        } else if(strcmp(argv[i], "-j") == 0 && (i + 1 < argc)) {
+            try {
+                workers = allpix::from_string<unsigned int>(argv[++i]);
+            } catch(std::invalid_argument& e) {
+                LOG(ERROR) << "Invalid number of worker processes \"" << std::string(argv[i])
+                           << "\", using a single process";
+            }
+        } else if(strcmp(argv[i], "--resume") == 0) {
+            module_options.emplace_back("resume=true");
         } else {
             LOG(ERROR) << "Unrecognized command line argument \"" << argv[i] << "\"";
             print_help = true;
@@ -145,6 +167,8 @@ int main(int argc, const char* argv[]) {
         std::cout << "  -o <option>  extra module configuration option(s) to pass" << std::endl;
         std::cout << "  -g <option>  extra detector configuration options(s) to pass" << std::endl;
         std::cout << "  -v <level>   verbosity level, overwriting the global level" << std::endl;
+        std::cout << "  -j <workers> split the events into multiple worker processes" << std::endl;
+        std::cout << "  --resume     resume the simulation from the last checkpoint" << std::endl;
         std::cout << "  --version    print version information and quit" << std::endl;
         std::cout << std::endl;
         std::cout << "For more help, please see <https://cern.ch/allpix-squared>" << std::endl;
@@ -174,21 +198,28 @@ int main(int argc, const char* argv[]) {
     }
 
     try {
-        // Construct main Allpix object
-        apx = std::make_unique<Allpix>(config_file_name, module_options, detector_options);
-        apx_ready = true;
+        if(workers > 1) {
+            // Run the simulation in worker processes and merge their output
+            splitter = std::make_unique<JobSplitter>(config_file_name, module_options, detector_options, workers);
+            splitter_ready = true;
+            splitter->run(argv[0]);
+        } else {
+            // Construct main Allpix object
+            apx = std::make_unique<Allpix>(config_file_name, module_options, detector_options);
+            apx_ready = true;
 
-        // Load modules
-        apx->load();
+            // Load modules
+            apx->load();
 
-        // Initialize modules (pre-run)
-        apx->init();
+            // Initialize modules (pre-run)
+            apx->init();
 
-        // Run modules and event-loop
-        apx->run();
+            // Run modules and event-loop
+            apx->run();
 
-        // Finalize modules (post-run)
-        apx->finalize();
+            // Finalize modules (post-run)
+            apx->finalize();
+        }
     } catch(ConfigurationError& e) {
         LOG(FATAL) << "Error in the configuration:" << std::endl
                    << e.what() << std::endl
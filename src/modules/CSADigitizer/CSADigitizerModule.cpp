@@ -11,6 +11,7 @@
 
 #include "core/utils/unit.h"
 #include "tools/ROOT.h"
+#include "tools/convolution.h"
 
 #include <TFile.h>
 #include <TGraph.h>
@@ -32,6 +33,8 @@ CSADigitizerModule::CSADigitizerModule(Configuration& config, Messenger* messeng
 
     // Seed the random generator with the global seed
     random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
 
     // Read model
     auto model = config_.get<std::string>("model");
@@ -134,8 +137,13 @@ void CSADigitizerModule::init() {
 }
 
 void CSADigitizerModule::run(unsigned int event_num) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
+
     // Loop through all pixels with charges
-    std::vector<PixelHit> hits;
+    auto hits = messenger_->createMessageData<PixelHit>();
     for(auto& pixel_charge : pixel_message_->getData()) {
         auto pixel = pixel_charge.getPixel();
         auto pixel_index = pixel.getIndex();
@@ -161,23 +169,10 @@ void CSADigitizerModule::run(unsigned int event_num) {
                        << ", ntimepoints " << ntimepoints;
         });
 
-        std::vector<double> amplified_pulse_vec(ntimepoints);
-        auto input_length = pulse_vec.size();
         LOG(TRACE) << "Preparing pulse for pixel " << pixel_index << ", " << pulse_vec.size() << " bins of "
                    << Units::display(timestep, {"ps", "ns"}) << ", total charge: " << Units::display(pulse.getCharge(), "e");
-        // convolution of the pulse (size input_length) with the impulse response (size ntimepoints)
-        for(size_t k = 0; k < ntimepoints; ++k) {
-            double outsum{};
-            // convolution: multiply pulse_vec.at(k - i) * impulse_response_function_.at(i), when (k - i) < input_length
-            // -> no point to start i at 0, start from jmin:
-            size_t jmin = (k >= input_length - 1) ? k - (input_length - 1) : 0;
-            for(size_t i = jmin; i <= k; ++i) {
-                if((k - i) < input_length) {
-                    outsum += pulse_vec.at(k - i) * impulse_response_function_.at(i);
-                }
-            }
-            amplified_pulse_vec.at(k) = outsum;
-        }
+        // convolution of the pulse with the impulse response (size ntimepoints)
+        auto amplified_pulse_vec = convolve(pulse_vec, impulse_response_function_);
 
         // apply noise on the amplified pulse
         std::normal_distribution<double> pulse_smearing(0, sigmaNoise_);
@@ -234,7 +229,7 @@ void CSADigitizerModule::run(unsigned int event_num) {
 
     if(!hits.empty()) {
         // Create and dispatch hit message
-        auto hits_message = std::make_shared<PixelHitMessage>(std::move(hits), getDetector());
+        auto hits_message = messenger_->createMessage<PixelHitMessage>(std::move(hits), getDetector());
         messenger_->dispatchMessage(this, hits_message);
     }
 }
@@ -306,3 +301,11 @@ void CSADigitizerModule::finalize() {
         h_pxq_vs_tot->Write();
     }
 }
+
+void CSADigitizerModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n';
+}
+
+void CSADigitizerModule::loadState(std::istream& stream) {
+    stream >> random_generator_;
+}
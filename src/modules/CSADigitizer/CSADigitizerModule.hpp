@@ -68,6 +68,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         // Control of module output settings
         bool output_plots_{}, output_pulsegraphs_{}, store_tot_{true};
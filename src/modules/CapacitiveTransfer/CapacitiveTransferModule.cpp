@@ -337,7 +337,7 @@ void CapacitiveTransferModule::run(unsigned int) {
 
     // Create pixel charges
     LOG(TRACE) << "Combining charges at same pixel";
-    std::vector<PixelCharge> pixel_charges;
+    auto pixel_charges = messenger_->createMessageData<PixelCharge>();
     for(auto& pixel_index_charge : pixel_map) {
         double charge = pixel_index_charge.second.first;
 
@@ -352,7 +352,7 @@ void CapacitiveTransferModule::run(unsigned int) {
     total_transferred_charges_ += transferred_charges_count;
 
     // Dispatch message of pixel charges
-    auto pixel_message = std::make_shared<PixelChargeMessage>(pixel_charges, detector_);
+    auto pixel_message = messenger_->createMessage<PixelChargeMessage>(std::move(pixel_charges), detector_);
     messenger_->dispatchMessage(this, pixel_message);
 }
 
@@ -31,6 +31,8 @@ DefaultDigitizerModule::DefaultDigitizerModule(Configuration& config,
 
     // Seed the random generator with the global seed
     random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
 
     config_.setAlias("qdc_resolution", "adc_resolution", true);
     config_.setAlias("qdc_smearing", "adc_smearing", true);
@@ -148,8 +150,13 @@ void DefaultDigitizerModule::init() {
 }
 
 void DefaultDigitizerModule::run(unsigned int) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
+
     // Loop through all pixels with charges
-    std::vector<PixelHit> hits;
+    auto hits = messenger_->createMessageData<PixelHit>();
     for(auto& pixel_charge : pixel_message_->getData()) {
         auto pixel = pixel_charge.getPixel();
         auto pixel_index = pixel.getIndex();
@@ -275,7 +282,7 @@ void DefaultDigitizerModule::run(unsigned int) {
 
     if(!hits.empty()) {
         // Create and dispatch hit message
-        auto hits_message = std::make_shared<PixelHitMessage>(std::move(hits), getDetector());
+        auto hits_message = messenger_->createMessage<PixelHitMessage>(std::move(hits), getDetector());
         messenger_->dispatchMessage(this, hits_message);
     }
 }
@@ -331,3 +338,11 @@ void DefaultDigitizerModule::finalize() {
 
     LOG(INFO) << "Digitized " << total_hits_ << " pixel hits in total";
 }
+
+void DefaultDigitizerModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n';
+}
+
+void DefaultDigitizerModule::loadState(std::istream& stream) {
+    stream >> random_generator_;
+}
@@ -58,6 +58,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         std::mt19937_64 random_generator_;
 
@@ -10,6 +10,7 @@
 
 #include "DepositionGeant4Module.hpp"
 
+#include <array>
 #include <limits>
 #include <string>
 #include <utility>
@@ -23,6 +24,8 @@
 #include <G4StepLimiterPhysics.hh>
 #include <G4UImanager.hh>
 #include <G4UserLimits.hh>
+#include <G4Version.hh>
+#include <Randomize.hh>
 
 #include "G4FieldManager.hh"
 #include "G4TransportationManager.hh"
@@ -31,12 +34,15 @@
 #include "core/config/exceptions.h"
 #include "core/geometry/GeometryManager.hpp"
 #include "core/module/exceptions.h"
+#include "core/utils/file.h"
+#include "core/utils/hash.h"
 #include "core/utils/log.h"
 #include "objects/DepositedCharge.hpp"
 #include "tools/ROOT.h"
 #include "tools/geant4.h"
 
 #include "GeneratorActionG4.hpp"
+#include "MagneticFieldG4.hpp"
 #include "SensitiveDetectorActionG4.hpp"
 #include "SetTrackInfoUserHookG4.hpp"
 
@@ -49,6 +55,8 @@ using namespace allpix;
  */
 DepositionGeant4Module::DepositionGeant4Module(Configuration& config, Messenger* messenger, GeometryManager* geo_manager)
     : Module(config), messenger_(messenger), geo_manager_(geo_manager), last_event_num_(1), run_manager_g4_(nullptr) {
+    // Store the state of the random generators in checkpoints
+    enable_checkpointing();
 
     // Set default physics list
     config_.setDefault("physics_list", "FTFP_BERT_LIV");
@@ -205,6 +213,29 @@ void DepositionGeant4Module::init() {
         world_log_volume->SetUserLimits(user_limits_world_.get());
     }
 
+    // Retrieve the physics tables if they have been stored for the same geometry and physics configuration before
+    std::string physics_table_directory;
+    bool store_physics_tables = false;
+    if(config_.has("cache_directory")) {
+        // The tables depend on the Geant4 version and on all materials, including the one of the world volume
+        std::string physics_description = G4Version + " " + geo_manager_->getConfigurationHash() + " " +
+                                          config_.get<std::string>("physics_list") + " " + allpix::to_string(production_cut);
+        if(world_log_volume != nullptr) {
+            physics_description += " " + world_log_volume->GetMaterial()->GetName();
+        }
+        if(config_.get<bool>("enable_pai", false)) {
+            physics_description += " " + config_.get<std::string>("pai_model", "pai");
+        }
+        physics_table_directory = config_.getPath("cache_directory") + "/physics_" + stable_hash(physics_description);
+
+        if(path_is_directory(physics_table_directory)) {
+            LOG(INFO) << "Retrieving Geant4 physics tables from " << physics_table_directory;
+            physicsList->SetPhysicsTableRetrieved(physics_table_directory);
+        } else {
+            store_physics_tables = true;
+        }
+    }
+
     // Initialize the physics list
     LOG(TRACE) << "Initializing physics processes";
     run_manager_g4_->SetUserInitialization(physicsList);
@@ -218,7 +249,20 @@ void DepositionGeant4Module::init() {
     auto generator = new GeneratorActionG4(config_);
     run_manager_g4_->SetUserAction(generator);
 
-    track_info_manager_ = std::make_unique<TrackInfoManager>();
+    // Select the Monte Carlo tracks to be stored
+    auto track_storage = config_.get<std::string>("mc_track_storage", "sensors");
+    std::transform(track_storage.begin(), track_storage.end(), track_storage.begin(), ::tolower);
+    TrackStoragePolicy track_policy;
+    if(track_storage == "sensors") {
+        track_policy = TrackStoragePolicy::SENSORS;
+    } else if(track_storage == "ancestors") {
+        track_policy = TrackStoragePolicy::ANCESTORS;
+    } else if(track_storage == "all") {
+        track_policy = TrackStoragePolicy::ALL;
+    } else {
+        throw InvalidValueError(config_, "mc_track_storage", "storage policy should be 'sensors', 'ancestors' or 'all'");
+    }
+    track_info_manager_ = std::make_unique<TrackInfoManager>(track_policy, config_.get<size_t>("max_mc_tracks", 0));
 
     // User hook to store additional information at track initialization and termination as well as custom track ids
     auto userTrackIDHook = new SetTrackInfoUserHookG4(track_info_manager_.get());
@@ -234,7 +278,13 @@ void DepositionGeant4Module::init() {
             globalFieldMgr->SetDetectorField(magField);
             globalFieldMgr->CreateChordFinder(magField);
         } else {
-            throw ModuleError("Magnetic field enabled, but not constant. This can't be handled by this module yet.");
+            // Query the position-dependent field from the geometry manager
+            auto geo_manager = geo_manager_;
+            G4MagneticField* magField = new MagneticFieldG4(
+                [geo_manager](const ROOT::Math::XYZPoint& pos) { return geo_manager->getMagneticField(pos); });
+            G4FieldManager* globalFieldMgr = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+            globalFieldMgr->SetDetectorField(magField);
+            globalFieldMgr->CreateChordFinder(magField);
         }
     }
 
@@ -258,7 +308,7 @@ void DepositionGeant4Module::init() {
         // Do not add sensitive detector for detectors that have no listeners for the deposited charges
         // FIXME Probably the MCParticle has to be checked as well
         if(!messenger_->hasReceiver(this,
-                                    std::make_shared<DepositedChargeMessage>(std::vector<DepositedCharge>(), detector))) {
+                                    std::make_shared<DepositedChargeMessage>(MessageData<DepositedCharge>(), detector))) {
             LOG(INFO) << "Not depositing charges in " << detector->getName()
                       << " because there is no listener for its output";
             continue;
@@ -305,6 +355,25 @@ void DepositionGeant4Module::init() {
     ui_g4->ApplyCommand("/process/eLoss/verbose 0");
     G4HadronicProcessStore::Instance()->SetVerbose(0);
 
+    // Build the physics tables before the first event if they should be cached, and store them
+    if(!physics_table_directory.empty()) {
+        LOG(TRACE) << "Building physics tables";
+        run_manager_g4_->BeamOn(0);
+
+        if(store_physics_tables) {
+            LOG(INFO) << "Storing Geant4 physics tables in " << physics_table_directory;
+            try {
+                create_directories(physics_table_directory);
+                if(!physicsList->StorePhysicsTable(physics_table_directory)) {
+                    LOG(WARNING) << "Could not store Geant4 physics tables, removing incomplete cache";
+                    remove_path(physics_table_directory);
+                }
+            } catch(std::invalid_argument& e) {
+                LOG(WARNING) << "Cannot cache Geant4 physics tables in " << physics_table_directory << ": " << e.what();
+            }
+        }
+    }
+
     // Set the random seed for Geant4 generation
     ui_g4->ApplyCommand(seed_command);
 
@@ -319,6 +388,18 @@ void DepositionGeant4Module::run(unsigned int event_num) {
         SUPPRESS_STREAM(G4cout);
     }
 
+    // Seed Geant4 and the charge fluctuations in the sensors for this event if requested
+    if(hasEventSeeds()) {
+        std::array<long, G4_NUM_SEEDS + 1> seeds{};
+        for(int i = 0; i < G4_NUM_SEEDS; ++i) {
+            seeds.at(static_cast<size_t>(i)) = static_cast<long>(getRandomSeed() % INT_MAX);
+        }
+        G4Random::setTheSeeds(seeds.data());
+        for(auto& sensor : sensors_) {
+            sensor->setSeed(getRandomSeed());
+        }
+    }
+
     // Start a single event from the beam
     LOG(TRACE) << "Enabling beam";
     run_manager_g4_->BeamOn(static_cast<int>(config_.get<unsigned int>("number_of_particles", 1)));
@@ -368,3 +449,23 @@ void DepositionGeant4Module::finalize() {
         LOG(WARNING) << "No charges deposited";
     }
 }
+
+/**
+ * The Geant4 random engine is used to generate the primary particles and to simulate their interactions, while the
+ * sensitive detectors use their own generators for the fluctuations of the number of deposited charges.
+ */
+void DepositionGeant4Module::saveState(std::ostream& stream) {
+    G4Random::getTheEngine()->put(stream);
+    stream << '\n' << last_event_num_ << '\n';
+    for(auto& sensor : sensors_) {
+        sensor->saveState(stream);
+    }
+}
+
+void DepositionGeant4Module::loadState(std::istream& stream) {
+    G4Random::getTheEngine()->get(stream);
+    stream >> last_event_num_;
+    for(auto& sensor : sensors_) {
+        sensor->loadState(stream);
+    }
+}
@@ -61,6 +61,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the state of the Geant4 random engine and of the sensitive detectors in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the Geant4 random engine and of the sensitive detectors from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         Messenger* messenger_;
         GeometryManager* geo_manager_;
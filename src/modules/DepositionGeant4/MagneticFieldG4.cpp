@@ -0,0 +1,20 @@
+/**
+ * @file
+ * @brief Implements a Geant4 magnetic field retrieving the field from the geometry manager
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "MagneticFieldG4.hpp"
+
+using namespace allpix;
+
+void MagneticFieldG4::GetFieldValue(const G4double point[4], G4double* bfield) const {
+    auto field = function_(ROOT::Math::XYZPoint(point[0], point[1], point[2]));
+    bfield[0] = field.x();
+    bfield[1] = field.y();
+    bfield[2] = field.z();
+}
@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @brief Defines a Geant4 magnetic field retrieving the field from the geometry manager
+ *
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef MagneticFieldG4_H
+#define MagneticFieldG4_H 1
+
+#include <utility>
+
+#include "G4MagneticField.hh"
+
+#include "core/geometry/GeometryManager.hpp"
+
+namespace allpix {
+    /**
+     * @brief Position-dependent magnetic field forwarding the queries of Geant4 to the global magnetic field function
+     */
+    class MagneticFieldG4 : public G4MagneticField {
+    public:
+        /**
+         * @brief Constructor taking the magnetic field function
+         * @param function Function returning the magnetic field at a global position
+         */
+        explicit MagneticFieldG4(MagneticFieldFunction function) : function_(std::move(function)){};
+
+        /**
+         * @brief Default destructor
+         */
+        ~MagneticFieldG4() override = default;
+
+        /**
+         * @brief Called by Geant4 to retrieve the magnetic field at a position
+         * @param point Global position and time of the query
+         * @param bfield Magnetic field vector to fill
+         */
+        void GetFieldValue(const G4double point[4], G4double* bfield) const override;
+
+    private:
+        MagneticFieldFunction function_;
+    };
+
+} // namespace allpix
+#endif /* MagneticFieldG4_H */
@@ -136,17 +136,29 @@ std::string SensitiveDetectorActionG4::getName() {
     return detector_->getName();
 }
 
+void SensitiveDetectorActionG4::setSeed(uint64_t random_seed) {
+    random_generator_.seed(random_seed);
+}
+
 unsigned int SensitiveDetectorActionG4::getTotalDepositedCharge() {
     return total_deposited_charge_;
 }
 
+void SensitiveDetectorActionG4::saveState(std::ostream& stream) const {
+    stream << random_generator_ << '\n' << total_deposited_charge_ << '\n';
+}
+
+void SensitiveDetectorActionG4::loadState(std::istream& stream) {
+    stream >> random_generator_ >> total_deposited_charge_;
+}
+
 unsigned int SensitiveDetectorActionG4::getDepositedCharge() {
     return deposited_charge_;
 }
 
 void SensitiveDetectorActionG4::dispatchMessages() {
     // Create the mc particles
-    std::vector<MCParticle> mc_particles;
+    auto mc_particles = messenger_->createMessageData<MCParticle>();
     for(auto& track_id_point : track_begin_) {
         auto track_id = track_id_point.first;
         auto local_begin = track_id_point.second;
@@ -181,7 +193,7 @@ void SensitiveDetectorActionG4::dispatchMessages() {
     }
 
     // Send the mc particle information
-    auto mc_particle_message = std::make_shared<MCParticleMessage>(std::move(mc_particles), detector_);
+    auto mc_particle_message = messenger_->createMessage<MCParticleMessage>(std::move(mc_particles), detector_);
     messenger_->dispatchMessage(module_, mc_particle_message);
 
     // Clear track data for the next event
@@ -207,7 +219,7 @@ void SensitiveDetectorActionG4::dispatchMessages() {
         }
 
         // Create a new charge deposit message
-        auto deposit_message = std::make_shared<DepositedChargeMessage>(std::move(deposits_), detector_);
+        auto deposit_message = messenger_->createMessage<DepositedChargeMessage>(std::move(deposits_), detector_);
 
         // Dispatch the message
         messenger_->dispatchMessage(module_, deposit_message);
@@ -216,7 +228,7 @@ void SensitiveDetectorActionG4::dispatchMessages() {
     deposited_charge_ = charges;
 
     // Clear deposits for next event
-    deposits_ = std::vector<DepositedCharge>();
+    deposits_ = messenger_->createMessageData<DepositedCharge>();
 
     // Clear link tables for next event
     deposit_to_id_.clear();
@@ -10,6 +10,7 @@
 #ifndef ALLPIX_SIMPLE_DEPOSITION_MODULE_SENSITIVE_DETECTOR_ACTION_H
 #define ALLPIX_SIMPLE_DEPOSITION_MODULE_SENSITIVE_DETECTOR_ACTION_H
 
+#include <iostream>
 #include <memory>
 
 #include <G4VSensitiveDetector.hh>
@@ -63,6 +64,12 @@ namespace allpix {
          */
         std::string getName();
 
+        /**
+         * @brief Seed the random number generator for the Fano fluctuations
+         * @param random_seed Seed for the random number generator
+         */
+        void setSeed(uint64_t random_seed);
+
         /**
          * @brief Process a single step of a particle passage through this sensor
          * @param step Information about the step
@@ -75,6 +82,18 @@ namespace allpix {
          */
         void dispatchMessages();
 
+        /**
+         * @brief Store the state of the random generator and the charge statistics in a checkpoint
+         * @param stream Stream to write the state to
+         */
+        void saveState(std::ostream& stream) const;
+
+        /**
+         * @brief Restore the state stored by \ref SensitiveDetectorActionG4::saveState
+         * @param stream Stream to read the state from
+         */
+        void loadState(std::istream& stream);
+
     private:
         // Instantatiation of the deposition module
         Module* module_;
@@ -94,7 +113,7 @@ namespace allpix {
         unsigned int deposited_charge_{};
 
         // Set of deposited charges in this event
-        std::vector<DepositedCharge> deposits_;
+        MessageData<DepositedCharge> deposits_;
 
         // List of begin points for tracks
         std::map<int, ROOT::Math::XYZPoint> track_begin_;
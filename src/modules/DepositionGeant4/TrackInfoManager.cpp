@@ -11,40 +11,98 @@
 
 using namespace allpix;
 
-TrackInfoManager::TrackInfoManager() : counter_(1) {}
+TrackInfoManager::TrackInfoManager(TrackStoragePolicy policy, size_t max_tracks)
+    : policy_(policy), max_tracks_(max_tracks), counter_(1) {}
 
 std::unique_ptr<TrackInfoG4> TrackInfoManager::makeTrackInfo(const G4Track* const track) {
     auto custom_id = counter_++;
     auto G4ParentID = track->GetParentID();
-    auto parent_track_id = G4ParentID == 0 ? G4ParentID : g4_to_custom_id_.at(G4ParentID);
-    g4_to_custom_id_[track->GetTrackID()] = custom_id;
-    track_id_to_parent_id_[custom_id] = parent_track_id;
+    auto parent_track_id = G4ParentID == 0 ? G4ParentID : g4_to_custom_id_.at(static_cast<size_t>(G4ParentID));
+
+    auto G4TrackID = static_cast<size_t>(track->GetTrackID());
+    if(g4_to_custom_id_.size() <= G4TrackID) {
+        g4_to_custom_id_.resize(G4TrackID + 1, 0);
+    }
+    g4_to_custom_id_[G4TrackID] = custom_id;
+    parent_ids_.push_back(parent_track_id);
+    track_states_.push_back(TrackState::NONE);
     return std::make_unique<TrackInfoG4>(custom_id, parent_track_id, track);
 }
 
 void TrackInfoManager::setTrackInfoToBeStored(int track_id) {
-    auto element = std::find(to_store_track_ids_.begin(), to_store_track_ids_.end(), track_id);
-    // If track id is not present we add it, otherwise skip as we only need each track once
-    if(element == to_store_track_ids_.end()) {
-        to_store_track_ids_.emplace_back(track_id);
+    auto index = static_cast<size_t>(track_id - 1);
+    // Only register tracks once, as we only need each track once
+    if(index < track_states_.size() && track_states_[index] == TrackState::NONE) {
+        track_states_[index] = TrackState::REQUESTED;
     }
 }
 
 void TrackInfoManager::storeTrackInfo(std::unique_ptr<TrackInfoG4> the_track_info) {
-    auto track_id = the_track_info->getID();
-    auto element = std::find(to_store_track_ids_.begin(), to_store_track_ids_.end(), track_id);
-    if(element != to_store_track_ids_.end()) {
-        stored_track_infos_.push_back(std::move(the_track_info));
-        to_store_track_ids_.erase(element);
+    auto index = static_cast<size_t>(the_track_info->getID() - 1);
+    if(index >= track_states_.size()) {
+        return;
+    }
+
+    // Keep the tracks until the end of the event if their selection depends on their descendants
+    if(policy_ == TrackStoragePolicy::ANCESTORS) {
+        if(retained_track_infos_.size() <= index) {
+            retained_track_infos_.resize(index + 1);
+        }
+        retained_track_infos_[index] = std::move(the_track_info);
+        return;
+    }
+
+    if(policy_ == TrackStoragePolicy::ALL || track_states_[index] == TrackState::REQUESTED) {
+        track_states_[index] = TrackState::STORED;
+        store_track(std::move(the_track_info));
+    }
+}
+
+void TrackInfoManager::store_track(std::unique_ptr<TrackInfoG4> the_track_info) {
+    if(max_tracks_ != 0 && stored_track_infos_.size() >= max_tracks_) {
+        truncated_tracks_++;
+        return;
     }
+    stored_track_infos_.push_back(std::move(the_track_info));
+}
+
+void TrackInfoManager::select_retained_tracks() {
+    // Register the ancestors of all registered tracks, parents always have a lower id than their children
+    size_t ancestors = 0;
+    for(size_t index = 0; index < track_states_.size(); ++index) {
+        if(track_states_[index] != TrackState::REQUESTED) {
+            continue;
+        }
+        auto parent_id = parent_ids_[index];
+        while(parent_id != 0 && track_states_[static_cast<size_t>(parent_id - 1)] == TrackState::NONE) {
+            track_states_[static_cast<size_t>(parent_id - 1)] = TrackState::REQUESTED;
+            parent_id = parent_ids_[static_cast<size_t>(parent_id - 1)];
+            ancestors++;
+        }
+    }
+    LOG(DEBUG) << "Registered " << ancestors << " ancestors of tracks depositing energy in a sensor to be stored";
+
+    // Store the selected tracks in the order of their creation
+    for(size_t index = 0; index < retained_track_infos_.size(); ++index) {
+        if(retained_track_infos_[index] == nullptr) {
+            continue;
+        }
+        if(track_states_[index] == TrackState::REQUESTED) {
+            track_states_[index] = TrackState::STORED;
+            store_track(std::move(retained_track_infos_[index]));
+        }
+    }
+    retained_track_infos_.clear();
 }
 
 void TrackInfoManager::resetTrackInfoManager() {
     counter_ = 1;
+    truncated_tracks_ = 0;
     stored_tracks_.clear();
-    to_store_track_ids_.clear();
     g4_to_custom_id_.clear();
-    track_id_to_parent_id_.clear();
+    parent_ids_.clear();
+    track_states_.clear();
+    retained_track_infos_.clear();
     stored_track_infos_.clear();
     stored_track_ids_.clear();
     id_to_track_.clear();
@@ -59,18 +117,29 @@ void TrackInfoManager::dispatchMessage(Module* module, Messenger* messenger) {
                        << " and terminates at: " << Units::display(mc_track.getEndPoint(), {"mm", "um"});
         }
     }
-    auto mc_track_message = std::make_shared<MCTrackMessage>(std::move(stored_tracks_));
+    auto mc_track_message = messenger->createMessage<MCTrackMessage>(std::move(stored_tracks_));
     messenger->dispatchMessage(module, mc_track_message);
 }
 
 MCTrack const* TrackInfoManager::findMCTrack(int track_id) const {
-    auto it = id_to_track_.find(track_id);
-    return (it == id_to_track_.end()) ? nullptr : it->second;
+    if(track_id <= 0 || static_cast<size_t>(track_id) > id_to_track_.size()) {
+        return nullptr;
+    }
+    return id_to_track_[static_cast<size_t>(track_id - 1)];
 }
 
 void TrackInfoManager::createMCTracks() {
+    if(policy_ == TrackStoragePolicy::ANCESTORS) {
+        select_retained_tracks();
+    }
+    if(truncated_tracks_ > 0) {
+        LOG(WARNING) << "Reached maximum of " << max_tracks_ << " stored MC tracks, discarded " << truncated_tracks_
+                     << " tracks in this event";
+    }
+
     // Reserve size so we don't move the vector around and change addresses:
     stored_tracks_.reserve(stored_track_infos_.size());
+    id_to_track_.assign(track_states_.size(), nullptr);
 
     for(auto& track_info : stored_track_infos_) {
         stored_tracks_.emplace_back(track_info->getStartPoint(),
@@ -84,7 +153,7 @@ void TrackInfoManager::createMCTracks() {
                                     track_info->getTotalEnergyInitial(),
                                     track_info->getTotalEnergyFinal());
 
-        id_to_track_[track_info->getID()] = &stored_tracks_.back();
+        id_to_track_[static_cast<size_t>(track_info->getID() - 1)] = &stored_tracks_.back();
         stored_track_ids_.emplace_back(track_info->getID());
     }
 }
@@ -92,7 +161,7 @@ void TrackInfoManager::createMCTracks() {
 void TrackInfoManager::set_all_track_parents() {
     for(size_t ix = 0; ix < stored_track_ids_.size(); ++ix) {
         auto track_id = stored_track_ids_[ix];
-        auto parent_id = track_id_to_parent_id_[track_id];
+        auto parent_id = parent_ids_[static_cast<size_t>(track_id - 1)];
         stored_tracks_[ix].setParent(findMCTrack(parent_id));
     }
 }
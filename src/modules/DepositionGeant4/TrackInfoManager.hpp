@@ -11,7 +11,9 @@
 #ifndef TrackInfoManager_H
 #define TrackInfoManager_H 1
 
-#include <map>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "G4Track.hh"
 #include "TrackInfoG4.hpp"
@@ -20,15 +22,30 @@
 #include "objects/MCTrack.hpp"
 
 namespace allpix {
+    /**
+     * @brief Policy selecting which tracks are stored as MCTrack objects
+     */
+    enum class TrackStoragePolicy {
+        SENSORS = 0, ///< Only tracks which deposited energy in a sensor are stored
+        ANCESTORS,   ///< Tracks which deposited energy in a sensor and all their ancestors are stored
+        ALL,         ///< All tracks are stored
+    };
+
     /**
      * @brief The TrackInfoManager is a factory for TrackInfoG4 objects and manages MCTracks within AP2
+     *
+     * The custom track ids are assigned consecutively starting from one for every event, such that all information about
+     * the tracks is kept in flat tables indexed by the track id. This allows constant-time lookups of the storage state,
+     * the parent and the created MCTrack of every track.
      */
     class TrackInfoManager {
     public:
         /**
-         * @brief Default constructor
+         * @brief Constructor
+         * @param policy Policy selecting the tracks to be stored
+         * @param max_tracks Maximum number of tracks stored per event, zero for no limit
          */
-        TrackInfoManager();
+        explicit TrackInfoManager(TrackStoragePolicy policy = TrackStoragePolicy::SENSORS, size_t max_tracks = 0);
 
         /**
          * @brief Factory method for TrackInfoG4 instances
@@ -44,7 +61,9 @@ namespace allpix {
          * @brief Will take a MCTrack and attempt to store it
          * @param the_track_info The MCTrack to be (possibly) stored
          *
-         * It will be stored if it was registered to be stored (@see #setTrackInfoToBeStored), otherwise deleted
+         * With the default policy, it will be stored if it was registered to be stored (@see #setTrackInfoToBeStored),
+         * otherwise deleted. If all tracks are stored, it is stored directly. If the ancestors of the registered tracks are
+         * stored, all tracks are retained until the end of the event and selected when creating the MCTrack objects.
          */
         void storeTrackInfo(std::unique_ptr<TrackInfoG4> the_track_info);
 
@@ -88,6 +107,26 @@ namespace allpix {
         MCTrack const* findMCTrack(int track_id) const;
 
     private:
+        /**
+         * @brief State of a track with respect to its storage
+         */
+        enum class TrackState : uint8_t {
+            NONE = 0,  ///< Track is not registered to be stored
+            REQUESTED, ///< Track is registered to be stored
+            STORED,    ///< Track information has been stored
+        };
+
+        /**
+         * @brief Select the registered tracks and all their ancestors from the retained track information
+         */
+        void select_retained_tracks();
+
+        /**
+         * @brief Add track information to the stored tracks unless the maximum number of tracks is reached
+         * @param the_track_info The track information to be stored
+         */
+        void store_track(std::unique_ptr<TrackInfoG4> the_track_info);
+
         /**
          * @brief Will internally set all the parent-child relations between stored tracks
          * @warning This must only be called once all the tracks are created (@see #createMCTracks) and no reallocation of
@@ -95,22 +134,31 @@ namespace allpix {
          */
         void set_all_track_parents();
 
+        // Policy selecting the tracks to be stored and the maximum number of stored tracks
+        TrackStoragePolicy policy_;
+        size_t max_tracks_;
+        // Number of tracks discarded in the current event after reaching the maximum number of tracks
+        size_t truncated_tracks_{};
+
         // Counter to store highest assigned track id
         int counter_{};
-        // Geant4 id to custom id translation
-        std::map<int, int> g4_to_custom_id_{};
-        // Custom id to custom parent id tracking
-        std::map<int, int> track_id_to_parent_id_{};
-        // List of track ids to be stored if they are provided via #storeTrackInfo
-        std::vector<int> to_store_track_ids_;
+        // Geant4 id to custom id translation, indexed by the Geant4 track id
+        std::vector<int> g4_to_custom_id_;
+        // Custom parent id, indexed by the custom id minus one
+        std::vector<int> parent_ids_;
+        // Storage state, indexed by the custom id minus one
+        std::vector<TrackState> track_states_;
+        // The TrackInfoG4 instances retained until the end of the event to select the ancestors, indexed by the custom id
+        // minus one
+        std::vector<std::unique_ptr<TrackInfoG4>> retained_track_infos_;
         // The TrackInfoG4 instances which are handed over to this track manager
         std::vector<std::unique_ptr<TrackInfoG4>> stored_track_infos_;
         // The MCTrack vector which is dispatched via #dispatchMessage
-        std::vector<MCTrack> stored_tracks_;
+        MessageData<MCTrack> stored_tracks_;
         // Ids ins same order as tracks stored in #stored_tracks_
         std::vector<int> stored_track_ids_;
-        // Id to index in #stored_tracks_ for easier handling
-        std::map<int, MCTrack const*> id_to_track_;
+        // Pointer to the track in #stored_tracks_, indexed by the custom id minus one
+        std::vector<MCTrack const*> id_to_track_;
     };
 } // namespace allpix
 #endif /* TrackInfoManager_H */
@@ -27,6 +27,8 @@ DepositionPointChargeModule::DepositionPointChargeModule(Configuration& config,
 
     // Seed the random generator with the global seed
     random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
 
     // Allow to use similar syntax as in DepositionGeant4:
     config_.setAlias("position", "source_position");
@@ -113,6 +115,10 @@ void DepositionPointChargeModule::init() {
 }
 
 void DepositionPointChargeModule::run(unsigned int event) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
 
     ROOT::Math::XYZPoint position;
     auto model = detector_->getModel();
@@ -163,8 +169,8 @@ void DepositionPointChargeModule::run(unsigned int event) {
 
 void DepositionPointChargeModule::DepositPoint(const ROOT::Math::XYZPoint& position) {
     // Vector of deposited charges and their "MCParticle"
-    std::vector<DepositedCharge> charges;
-    std::vector<MCParticle> mcparticles;
+    auto charges = messenger_->createMessageData<DepositedCharge>();
+    auto mcparticles = messenger_->createMessageData<MCParticle>();
 
     LOG(DEBUG) << "Position (local coordinates): " << Units::display(position, {"um", "mm"});
     // Cross-check calculated position to be within sensor:
@@ -186,10 +192,10 @@ void DepositionPointChargeModule::DepositPoint(const ROOT::Math::XYZPoint& posit
                << Units::display(position_global, {"um", "mm"}) << " in detector " << detector_->getName();
 
     // Dispatch the messages to the framework
-    auto mcparticle_message = std::make_shared<MCParticleMessage>(std::move(mcparticles), detector_);
+    auto mcparticle_message = messenger_->createMessage<MCParticleMessage>(std::move(mcparticles), detector_);
     messenger_->dispatchMessage(this, mcparticle_message);
 
-    auto deposit_message = std::make_shared<DepositedChargeMessage>(std::move(charges), detector_);
+    auto deposit_message = messenger_->createMessage<DepositedChargeMessage>(std::move(charges), detector_);
     messenger_->dispatchMessage(this, deposit_message);
 }
 
@@ -197,8 +203,8 @@ void DepositionPointChargeModule::DepositLine(const ROOT::Math::XYZPoint& positi
     auto model = detector_->getModel();
 
     // Vector of deposited charges and their "MCParticle"
-    std::vector<DepositedCharge> charges;
-    std::vector<MCParticle> mcparticles;
+    auto charges = messenger_->createMessageData<DepositedCharge>();
+    auto mcparticles = messenger_->createMessageData<MCParticle>();
 
     // Cross-check calculated position to be within sensor:
     if(!detector_->isWithinSensor(ROOT::Math::XYZPoint(position.x(), position.y(), 0))) {
@@ -230,9 +236,17 @@ void DepositionPointChargeModule::DepositLine(const ROOT::Math::XYZPoint& positi
     }
 
     // Dispatch the messages to the framework
-    auto mcparticle_message = std::make_shared<MCParticleMessage>(std::move(mcparticles), detector_);
+    auto mcparticle_message = messenger_->createMessage<MCParticleMessage>(std::move(mcparticles), detector_);
     messenger_->dispatchMessage(this, mcparticle_message);
 
-    auto deposit_message = std::make_shared<DepositedChargeMessage>(std::move(charges), detector_);
+    auto deposit_message = messenger_->createMessage<DepositedChargeMessage>(std::move(charges), detector_);
     messenger_->dispatchMessage(this, deposit_message);
 }
+
+void DepositionPointChargeModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n';
+}
+
+void DepositionPointChargeModule::loadState(std::istream& stream) {
+    stream >> random_generator_;
+}
@@ -57,6 +57,16 @@ namespace allpix {
          */
         void init() override;
 
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         /**
          * @brief Helper function to deposit charges at a single point
@@ -26,6 +26,7 @@ DepositionReaderModule::DepositionReaderModule(Configuration& config, Messenger*
     config_.setDefault<double>("charge_creation_energy", Units::get(3.64, "eV"));
     config_.setDefault<double>("fano_factor", 0.115);
     config_.setDefault<size_t>("detector_name_chars", 0);
+    config_.setDefault<bool>("assign_by_position", false);
     config_.setDefault<std::string>("unit_length", "mm");
     config_.setDefault<std::string>("unit_time", "ns");
     config_.setDefault<std::string>("unit_energy", "MeV");
@@ -49,6 +50,7 @@ DepositionReaderModule::DepositionReaderModule(Configuration& config, Messenger*
     charge_creation_energy_ = config_.get<double>("charge_creation_energy");
     fano_factor_ = config_.get<double>("fano_factor");
     volume_chars_ = config_.get<size_t>("detector_name_chars");
+    assign_by_position_ = config_.get<bool>("assign_by_position");
 
     unit_length_ = config_.get<std::string>("unit_length");
     unit_time_ = config_.get<std::string>("unit_time");
@@ -149,10 +151,14 @@ template <typename T> void DepositionReaderModule::check_tree_reader(std::shared
 }
 
 void DepositionReaderModule::run(unsigned int event) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
 
     // Set of deposited charges in this event
-    std::map<std::shared_ptr<Detector>, std::vector<DepositedCharge>> deposits;
-    std::map<std::shared_ptr<Detector>, std::vector<MCParticle>> mc_particles;
+    std::map<std::shared_ptr<Detector>, MessageData<DepositedCharge>> deposits;
+    std::map<std::shared_ptr<Detector>, MessageData<MCParticle>> mc_particles;
     std::map<std::shared_ptr<Detector>, std::vector<int>> particles_to_deposits;
     std::map<std::shared_ptr<Detector>, std::map<int, size_t>> track_id_to_mcparticle;
 
@@ -182,16 +188,28 @@ void DepositionReaderModule::run(unsigned int event) {
             break;
         }
 
-        auto detectors = geo_manager_->getDetectors();
-        auto pos = std::find_if(detectors.begin(), detectors.end(), [volume](const std::shared_ptr<Detector>& d) {
-            return d->getName() == volume;
-        });
-        if(pos == detectors.end()) {
-            LOG(TRACE) << "Ignored detector \"" << volume << "\", not found in current simulation";
-            continue;
-        }
         // Assign detector
-        auto detector = (*pos);
+        std::shared_ptr<Detector> detector;
+        if(assign_by_position_) {
+            // Take the first detector with the deposit inside its sensor, independent of the volume name
+            for(auto& candidate : geo_manager_->getDetectorsAt(global_deposit_position)) {
+                if(candidate->isWithinSensor(candidate->getLocalPosition(global_deposit_position))) {
+                    detector = candidate;
+                    break;
+                }
+            }
+            if(detector == nullptr) {
+                LOG(TRACE) << "Ignored deposition at " << Units::display(global_deposit_position, {"mm", "um"})
+                           << ", not within the sensor of any detector";
+                continue;
+            }
+        } else {
+            if(!geo_manager_->hasDetector(volume)) {
+                LOG(TRACE) << "Ignored detector \"" << volume << "\", not found in current simulation";
+                continue;
+            }
+            detector = geo_manager_->getDetector(volume);
+        }
         LOG(DEBUG) << "Found detector \"" << detector->getName() << "\"";
 
         auto deposit_position = detector->getLocalPosition(global_deposit_position);
@@ -247,7 +265,7 @@ void DepositionReaderModule::run(unsigned int event) {
         LOG(DEBUG) << "Detector " << detector->getName() << " has " << mc_particles[detector].size() << " MC particles";
 
         // Send the mc particle information
-        auto mc_particle_message = std::make_shared<MCParticleMessage>(std::move(mc_particles[detector]), detector);
+        auto mc_particle_message = messenger_->createMessage<MCParticleMessage>(std::move(mc_particles[detector]), detector);
         messenger_->dispatchMessage(this, mc_particle_message);
 
         if(!deposits[detector].empty()) {
@@ -262,7 +280,8 @@ void DepositionReaderModule::run(unsigned int event) {
 
             // Create a new charge deposit message
             LOG(DEBUG) << "Detector " << detector->getName() << " has " << deposits[detector].size() << " deposits";
-            auto deposit_message = std::make_shared<DepositedChargeMessage>(std::move(deposits[detector]), detector);
+            auto deposit_message =
+                messenger_->createMessage<DepositedChargeMessage>(std::move(deposits[detector]), detector);
 
             // Dispatch the message
             messenger_->dispatchMessage(this, deposit_message);
@@ -299,7 +318,12 @@ bool DepositionReaderModule::read_root(unsigned int event_num,
                                        int& track_id,
                                        int& parent_id) {
 
+    // Skip the entries of events before the current one, e.g. if the first events of the simulation are skipped
     auto status = tree_reader_->GetEntryStatus();
+    while(status == TTreeReader::kEntryValid && static_cast<unsigned int>(*event_->Get()) + 1 < event_num) {
+        tree_reader_->Next();
+        status = tree_reader_->GetEntryStatus();
+    }
     if(status == TTreeReader::kEntryNotFound || status == TTreeReader::kEntryBeyondEnd) {
         throw EndOfRunException("Requesting end of run: end of tree reached");
     } else if(status != TTreeReader::kEntryValid) {
@@ -359,12 +383,19 @@ bool DepositionReaderModule::read_csv(unsigned int event_num,
             std::stringstream lse(line);
             unsigned int event_read;
             lse >> tmp >> event_read;
+            csv_event_ = event_read;
             if(event_read + 1 > event_num) {
                 return false;
             }
             LOG(DEBUG) << "Parsed header of event " << event_read << ", continuing";
             continue;
         }
+
+        // Skip the deposits of events before the current one, e.g. if the first events of the simulation are skipped
+        if(!line.empty() && line.front() != '#' && csv_event_ + 1 < event_num) {
+            LOG(TRACE) << "Skipping deposit of event " << csv_event_;
+            line.clear();
+        }
     } while(line.empty() || line.front() == '#' || line.front() == 'E');
 
     std::istringstream ls(line);
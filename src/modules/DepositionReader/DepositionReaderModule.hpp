@@ -90,7 +90,10 @@ namespace allpix {
         double fano_factor_;
 
         std::string file_model_;
+        // Event number of the last header read from the CSV file
+        unsigned int csv_event_{};
         size_t volume_chars_{};
+        bool assign_by_position_{};
         std::string unit_length_{}, unit_time_{}, unit_energy_{};
 
         bool read_csv(unsigned int event_num,
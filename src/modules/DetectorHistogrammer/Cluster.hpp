@@ -12,10 +12,14 @@
 
 #include <Math/DisplacementVector2D.h>
 
+#include <map>
 #include <set>
+#include <vector>
 
+#include "core/utils/log.h"
 #include "objects/Pixel.hpp"
 #include "objects/PixelHit.hpp"
+#include "tools/ROOT.h"
 
 namespace allpix {
 
@@ -83,6 +87,13 @@ namespace allpix {
          */
         std::set<const MCParticle*> getMCParticles() const;
 
+        /**
+         * @brief Perform a sparse clustering on the PixelHits, grouping all adjacent pixels into clusters
+         * @param pixel_hits Container with all PixelHits of one detector
+         * @return List of clusters found
+         */
+        template <typename Container> static std::vector<Cluster> findClusters(const Container& pixel_hits);
+
     private:
         const PixelHit* seedPixelHit_;
 
@@ -93,5 +104,56 @@ namespace allpix {
 
         unsigned int minX_, minY_, maxX_, maxY_;
     };
+
+    template <typename Container> std::vector<Cluster> Cluster::findClusters(const Container& pixel_hits) {
+        std::vector<Cluster> clusters;
+        std::map<const PixelHit*, bool> usedPixel;
+
+        auto pixel_it = pixel_hits.begin();
+        for(; pixel_it != pixel_hits.end(); pixel_it++) {
+            const PixelHit* pixel_hit = &(*pixel_it);
+
+            // Check if the pixel has been used:
+            if(usedPixel[pixel_hit]) {
+                continue;
+            }
+
+            // Create new cluster
+            Cluster cluster(pixel_hit);
+            usedPixel[pixel_hit] = true;
+            LOG(TRACE) << "Creating new cluster with seed: " << pixel_hit->getPixel().getIndex();
+
+            auto touching = [&](const PixelHit* pixel) {
+                auto pxi1 = pixel->getIndex();
+                for(auto& cluster_pixel : cluster.getPixelHits()) {
+
+                    auto distance = [](unsigned int lhs, unsigned int rhs) { return (lhs > rhs ? lhs - rhs : rhs - lhs); };
+
+                    auto pxi2 = cluster_pixel->getIndex();
+                    if(distance(pxi1.x(), pxi2.x()) <= 1 && distance(pxi1.y(), pxi2.y()) <= 1) {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            // Keep adding pixels to the cluster:
+            for(auto other_pixel = pixel_it + 1; other_pixel != pixel_hits.end(); other_pixel++) {
+                const PixelHit* neighbor = &(*other_pixel);
+
+                // Check if neighbor has been used or if it touches the current cluster:
+                if(usedPixel[neighbor] || !touching(neighbor)) {
+                    continue;
+                }
+
+                cluster.addPixelHit(neighbor);
+                LOG(TRACE) << "Adding pixel: " << neighbor->getPixel().getIndex();
+                usedPixel[neighbor] = true;
+                other_pixel = pixel_it;
+            }
+            clusters.push_back(cluster);
+        }
+        return clusters;
+    }
 } // namespace allpix
 #endif /*ALLPIX_DETECTOR_HISTOGRAMMER_CLUSTER_H */
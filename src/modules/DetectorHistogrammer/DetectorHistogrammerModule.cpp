@@ -209,6 +209,11 @@ void DetectorHistogrammerModule::init() {
 void DetectorHistogrammerModule::run(unsigned int) {
     using namespace ROOT::Math;
 
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
+
     // Check that we actually received pixel hits - we might have none and just received MCParticles!
     LOG(DEBUG) << "Received " << (pixels_message_ != nullptr ? std::to_string(pixels_message_->getData().size()) : "no")
                << " pixel hits";
@@ -229,7 +234,10 @@ void DetectorHistogrammerModule::run(unsigned int) {
     }
 
     // Perform a clustering
-    std::vector<Cluster> clusters = doClustering();
+    std::vector<Cluster> clusters;
+    if(pixels_message_ != nullptr) {
+        clusters = Cluster::findClusters(pixels_message_->getData());
+    }
 
     // Lambda for smearing the Monte Carlo truth position with the track resolution
     auto track_smearing = [&](auto residuals) {
@@ -464,61 +472,6 @@ void DetectorHistogrammerModule::finalize() {
     seed_charge_map->Write();
 }
 
-std::vector<Cluster> DetectorHistogrammerModule::doClustering() {
-    std::vector<Cluster> clusters;
-    std::map<const PixelHit*, bool> usedPixel;
-
-    if(pixels_message_ == nullptr) {
-        return clusters;
-    }
-
-    auto pixel_it = pixels_message_->getData().begin();
-    for(; pixel_it != pixels_message_->getData().end(); pixel_it++) {
-        const PixelHit* pixel_hit = &(*pixel_it);
-
-        // Check if the pixel has been used:
-        if(usedPixel[pixel_hit]) {
-            continue;
-        }
-
-        // Create new cluster
-        Cluster cluster(pixel_hit);
-        usedPixel[pixel_hit] = true;
-        LOG(TRACE) << "Creating new cluster with seed: " << pixel_hit->getPixel().getIndex();
-
-        auto touching = [&](const PixelHit* pixel) {
-            auto pxi1 = pixel->getIndex();
-            for(auto& cluster_pixel : cluster.getPixelHits()) {
-
-                auto distance = [](unsigned int lhs, unsigned int rhs) { return (lhs > rhs ? lhs - rhs : rhs - lhs); };
-
-                auto pxi2 = cluster_pixel->getIndex();
-                if(distance(pxi1.x(), pxi2.x()) <= 1 && distance(pxi1.y(), pxi2.y()) <= 1) {
-                    return true;
-                }
-            }
-            return false;
-        };
-
-        // Keep adding pixels to the cluster:
-        for(auto other_pixel = pixel_it + 1; other_pixel != pixels_message_->getData().end(); other_pixel++) {
-            const PixelHit* neighbor = &(*other_pixel);
-
-            // Check if neighbor has been used or if it touches the current cluster:
-            if(usedPixel[neighbor] || !touching(neighbor)) {
-                continue;
-            }
-
-            cluster.addPixelHit(neighbor);
-            LOG(TRACE) << "Adding pixel: " << neighbor->getPixel().getIndex();
-            usedPixel[neighbor] = true;
-            other_pixel = pixel_it;
-        }
-        clusters.push_back(cluster);
-    }
-    return clusters;
-}
-
 std::vector<const MCParticle*> DetectorHistogrammerModule::getPrimaryParticles() const {
     std::vector<const MCParticle*> primaries;
 
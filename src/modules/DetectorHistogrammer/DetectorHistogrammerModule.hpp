@@ -61,11 +61,6 @@ namespace allpix {
         void finalize() override;
 
     private:
-        /**
-         * @brief Perform a sparse clustering on the PixelHits
-         */
-        std::vector<Cluster> doClustering();
-
         /**
          * @brief analyze the available MCParticles and return the all particles identified as primary (i.e. that do not have
          * a parent). This might be several particles.
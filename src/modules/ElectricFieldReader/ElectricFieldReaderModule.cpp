@@ -29,6 +29,9 @@ using namespace allpix;
 
 ElectricFieldReaderModule::ElectricFieldReaderModule(Configuration& config, Messenger*, std::shared_ptr<Detector> detector)
     : Module(config, detector), detector_(std::move(detector)) {
+    // No state changes during the event sequence, such that checkpoints do not need to store anything
+    enable_checkpointing();
+
     // NOTE use voltage as a synonym for bias voltage
     config_.setAlias("bias_voltage", "voltage");
 
@@ -37,6 +40,11 @@ ElectricFieldReaderModule::ElectricFieldReaderModule(Configuration& config, Mess
     if(model == "init" || model == "apf") {
         config_.set("model", "mesh");
     }
+
+    // Allow the field of all detectors to be loaded in parallel if no plots are created during initialization
+    if(!config_.get<bool>("output_plots", false)) {
+        enable_parallel_initialization();
+    }
 }
 
 void ElectricFieldReaderModule::init() {
@@ -68,7 +76,7 @@ void ElectricFieldReaderModule::init() {
     auto thickness_domain = std::make_pair(sensor_max_z - depletion_depth, sensor_max_z);
 
     // Calculate the field depending on the configuration
-    if(field_model == "mesh") {
+    if(field_model == "mesh" || field_model == "transient") {
         // Read the field scales from the configuration, defaulting to 1.0x1.0 pixel cell:
         auto scales = config_.get<ROOT::Math::XYVector>("field_scale", {1.0, 1.0});
         // FIXME Add sanity checks for scales here
@@ -87,10 +95,14 @@ void ElectricFieldReaderModule::init() {
         LOG(DEBUG) << "Electric field starts with offset " << offset << " to pixel boundary";
         std::array<double, 2> field_offset{{model->getPixelSize().x() * offset.x(), model->getPixelSize().y() * offset.y()}};
 
-        auto field_data = read_field(thickness_domain, field_scale);
+        if(field_model == "mesh") {
+            auto field_data = read_field(config_.getPath("file_name", true), thickness_domain, field_scale);
 
-        detector_->setElectricFieldGrid(
-            field_data.getData(), field_data.getDimensions(), field_scale, field_offset, thickness_domain);
+            detector_->setElectricFieldGrid(
+                field_data.getData(), field_data.getDimensions(), field_scale, field_offset, thickness_domain);
+        } else {
+            read_transient_field(thickness_domain, field_scale, field_offset);
+        }
     } else if(field_model == "constant") {
         LOG(TRACE) << "Adding constant electric field";
         type = FieldType::CONSTANT;
@@ -113,7 +125,7 @@ void ElectricFieldReaderModule::init() {
         FieldFunction<ROOT::Math::XYZVector> function = get_linear_field_function(depletion_voltage, thickness_domain);
         detector_->setElectricFieldFunction(function, thickness_domain, type);
     } else {
-        throw InvalidValueError(config_, "model", "model should be 'linear', 'constant' or 'init'");
+        throw InvalidValueError(config_, "model", "model should be 'linear', 'constant', 'mesh' or 'transient'");
     }
 
     // Produce histograms if needed
@@ -155,14 +167,15 @@ ElectricFieldReaderModule::get_linear_field_function(double depletion_voltage, s
  * FieldParser's getByFileName method.
  */
 FieldParser<double> ElectricFieldReaderModule::field_parser_(FieldQuantity::VECTOR);
-FieldData<double> ElectricFieldReaderModule::read_field(std::pair<double, double> thickness_domain,
+FieldData<double> ElectricFieldReaderModule::read_field(const std::string& file_name,
+                                                        std::pair<double, double> thickness_domain,
                                                         std::array<double, 2> field_scale) {
 
     try {
         LOG(TRACE) << "Fetching electric field from mesh file";
 
         // Get field from file
-        auto field_data = field_parser_.getByFileName(config_.getPath("file_name", true), "V/cm");
+        auto field_data = field_parser_.getByFileName(file_name, "V/cm");
 
         // Check if electric field matches chip
         check_detector_match(field_data.getSize(), thickness_domain, field_scale);
@@ -181,6 +194,63 @@ FieldData<double> ElectricFieldReaderModule::read_field(std::pair<double, double
     }
 }
 
+/**
+ * The field of the first time slice is loaded immediately and is also used as static electric field of the detector. Only
+ * the headers of the other slices are read to validate their dimensions, their data is read from file once they are
+ * requested during propagation.
+ */
+void ElectricFieldReaderModule::read_transient_field(std::pair<double, double> thickness_domain,
+                                                     std::array<double, 2> field_scale,
+                                                     std::array<double, 2> field_offset) {
+    auto file_names = config_.getPathArray("file_name", true);
+    auto times = config_.getArray<double>("field_times");
+    if(file_names.size() != times.size() || file_names.empty()) {
+        throw InvalidCombinationError(
+            config_, {"file_name", "field_times"}, "exactly one time has to be provided for every field file");
+    }
+
+    auto field_data = read_field(file_names.front(), thickness_domain, field_scale);
+    auto dimensions = field_data.getDimensions();
+    detector_->setElectricFieldGrid(field_data.getData(), dimensions, field_scale, field_offset, thickness_domain);
+
+    for(size_t i = 0; i < file_names.size(); ++i) {
+        auto file_name = file_names[i];
+        FieldData<double> header_data;
+        try {
+            header_data = field_parser_.getHeaderByFileName(file_name, "V/cm");
+        } catch(std::runtime_error& e) {
+            throw InvalidValueError(config_, "file_name", e.what());
+        }
+        check_detector_match(header_data.getSize(), thickness_domain, field_scale);
+        if(header_data.getDimensions() != dimensions) {
+            throw InvalidValueError(config_, "file_name", "all time slices need a field with identical dimensions");
+        }
+
+        auto loader = [file_name]() {
+            LOG(DEBUG) << "Loading electric field time slice from file " << file_name;
+            return field_parser_.getByFileName(file_name, "V/cm").getData();
+        };
+
+        try {
+            detector_->addElectricFieldSlice(
+                times[i], file_name, loader, dimensions, field_scale, field_offset, thickness_domain);
+        } catch(std::invalid_argument& e) {
+            throw InvalidValueError(config_, "field_times", e.what());
+        }
+    }
+
+    LOG(INFO) << "Set transient electric field with " << times.size() << " time slices between "
+              << Units::display(times.front(), {"ns", "us"}) << " and " << Units::display(times.back(), {"ns", "us"});
+}
+
+void ElectricFieldReaderModule::finalize() {
+    if(detector_->hasTransientElectricField()) {
+        const auto& field = detector_->getTransientElectricField();
+        LOG(STATUS) << "Loaded " << field.getLoadedFields() << " distinct electric fields for " << field.getSlices()
+                    << " time slices";
+    }
+}
+
 void ElectricFieldReaderModule::create_output_plots() {
     LOG(TRACE) << "Creating output plots";
 
@@ -27,6 +27,7 @@ namespace allpix {
      * Read the model of the electric field from the config during initialization:
      * - For a linear field create a constant electric field to apply over the whole sensitive device
      * - For the INIT format, reads the specified file and add the electric field grid to the bound detectors
+     * - For a transient field, register a sequence of field files as time slices which are read on first use
      */
     class ElectricFieldReaderModule : public Module {
     public:
@@ -43,6 +44,11 @@ namespace allpix {
          */
         void init() override;
 
+        /**
+         * @brief Report the number of loaded time slices for transient fields
+         */
+        void finalize() override;
+
     private:
         std::shared_ptr<Detector> detector_;
 
@@ -55,10 +61,23 @@ namespace allpix {
 
         /**
          * @brief Read field from a file in init or apf format and apply it
+         * @param file_name Canonical path of the field file
+         * @param thickness_domain Domain of the thickness where the field is defined
+         * @param field_scale Scaling parameters for the field size in x and y
+         */
+        FieldData<double> read_field(const std::string& file_name,
+                                     std::pair<double, double> thickness_domain,
+                                     std::array<double, 2> field_scale);
+
+        /**
+         * @brief Register the time slices of a transient field, which are read from file on first use
          * @param thickness_domain Domain of the thickness where the field is defined
          * @param field_scale Scaling parameters for the field size in x and y
+         * @param field_offset Offset of the field from the pixel edge in x and y
          */
-        FieldData<double> read_field(std::pair<double, double> thickness_domain, std::array<double, 2> field_scale);
+        void read_transient_field(std::pair<double, double> thickness_domain,
+                                  std::array<double, 2> field_scale,
+                                  std::array<double, 2> field_offset);
         static FieldParser<double> field_parser_;
 
         /**
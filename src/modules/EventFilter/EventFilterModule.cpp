@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief Implementation of module skipping events without sufficient deposited charge in a detector
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "EventFilterModule.hpp"
+
+#include <string>
+#include <utility>
+
+#include "core/module/exceptions.h"
+#include "core/utils/log.h"
+#include "core/utils/unit.h"
+
+using namespace allpix;
+
+EventFilterModule::EventFilterModule(Configuration& config, Messenger* messenger, std::shared_ptr<Detector> detector)
+    : Module(config, detector), detector_(std::move(detector)) {
+    // Enable parallelization of this module if multithreading is enabled
+    enable_parallelization();
+
+    // Only the statistics change during the event sequence, which are stored in the checkpoints
+    enable_checkpointing();
+
+    // By default only skip events without any deposited charge
+    config_.setDefault<unsigned long>("minimum_charge", 0);
+    minimum_charge_ = config_.get<unsigned long>("minimum_charge");
+
+    // Bind to all deposits of the detector, which are not required to allow filtering events without deposits
+    messenger->bindMulti(this, &EventFilterModule::messages_);
+}
+
+void EventFilterModule::run(unsigned int) {
+    total_events_++;
+
+    // Sum the charge of all deposits in the detector
+    unsigned long total_charge = 0;
+    size_t deposits = 0;
+    for(auto& message : messages_) {
+        for(auto& deposit : message->getData()) {
+            total_charge += deposit.getCharge();
+        }
+        deposits += message->getData().size();
+    }
+    LOG(DEBUG) << "Detector " << detector_->getName() << " received " << deposits << " deposits with a total charge of "
+               << Units::display(total_charge, "e");
+
+    if(deposits == 0) {
+        skipped_events_++;
+        throw SkipEventException("no charge deposited in detector " + detector_->getName());
+    }
+    if(total_charge < minimum_charge_) {
+        skipped_events_++;
+        throw SkipEventException("deposited charge of " + Units::display(total_charge, "e") + " is below the minimum of " +
+                                 Units::display(minimum_charge_, "e"));
+    }
+}
+
+void EventFilterModule::finalize() {
+    LOG(INFO) << "Skipped " << skipped_events_ << " of " << total_events_ << " events for detector " << detector_->getName()
+              << " with a deposited charge below " << Units::display(minimum_charge_, "e");
+}
+
+void EventFilterModule::saveState(std::ostream& stream) {
+    stream << total_events_ << " " << skipped_events_;
+}
+
+void EventFilterModule::loadState(std::istream& stream) {
+    unsigned long total_events = 0, skipped_events = 0;
+    stream >> total_events >> skipped_events;
+    total_events_ = total_events;
+    skipped_events_ = skipped_events;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file
+ * @brief Definition of module skipping events without sufficient deposited charge in a detector
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/Detector.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/DepositedCharge.hpp"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to skip the remaining modules of a detector if it received too little charge
+     *
+     * Sums the charge of all deposits in the detector and requests the framework to skip all following modules of the same
+     * detector in the current event if no charge has been deposited or the total charge is below the configured minimum.
+     */
+    class EventFilterModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this detector-specific module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param detector Pointer to the detector for this module instance
+         */
+        EventFilterModule(Configuration& config, Messenger* messenger, std::shared_ptr<Detector> detector);
+
+        /**
+         * @brief Check the deposited charge and skip the event for this detector if required
+         * @throws SkipEventException If the deposited charge is below the minimum
+         */
+        void run(unsigned int) override;
+
+        /**
+         * @brief Print statistics on the skipped events
+         */
+        void finalize() override;
+
+        /**
+         * @brief Store the statistics in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the statistics from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
+    private:
+        std::shared_ptr<Detector> detector_;
+
+        // Deposits received for the detector
+        std::vector<std::shared_ptr<DepositedChargeMessage>> messages_;
+
+        // Minimum charge to keep the event
+        unsigned long minimum_charge_{};
+
+        // Statistics
+        std::atomic<unsigned long> total_events_{};
+        std::atomic<unsigned long> skipped_events_{};
+    };
+} // namespace allpix
@@ -14,6 +14,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <sstream>
 #include <string>
@@ -61,6 +62,8 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
 
     // Seed the random generator with the module seed
     random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
 
     // Set default value for config variables
     config_.setDefault<double>("spatial_precision", Units::get(0.25, "nm"));
@@ -108,19 +111,11 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
     output_plots_step_ = config_.get<double>("output_plots_step");
     output_plots_lines_at_implants_ = config_.get<bool>("output_plots_lines_at_implants");
 
-    // Enable parallelization of this module if multithreading is enabled and no per-event output plots are requested:
-    if(!(output_animations_ || output_linegraphs_)) {
-        enable_parallelization();
-    }
-
-    // Parameterization variables from https://doi.org/10.1016/0038-1101(77)90054-5 (section 5.2)
-    electron_Vm_ = Units::get(1.53e9 * std::pow(temperature_, -0.87), "cm/s");
-    electron_Ec_ = Units::get(1.01 * std::pow(temperature_, 1.55), "V/cm");
-    electron_Beta_ = 2.57e-2 * std::pow(temperature_, 0.66);
+    // Enable parallelization of this module if multithreading is enabled, per-event output plots are created one at a time
+    enable_parallelization();
 
-    hole_Vm_ = Units::get(1.62e8 * std::pow(temperature_, -0.52), "cm/s");
-    hole_Ec_ = Units::get(1.24 * std::pow(temperature_, 1.68), "V/cm");
-    hole_Beta_ = 0.46 * std::pow(temperature_, 0.17);
+    // Precalculate the parameters of the carrier mobility
+    mobility_ = JacoboniCanaliMobility(temperature_);
 
     boltzmann_kT_ = Units::get(8.6173e-5, "eV/K") * temperature_;
 
@@ -131,6 +126,10 @@ GenericPropagationModule::GenericPropagationModule(Configuration& config,
 }
 
 void GenericPropagationModule::create_output_plots(unsigned int event_num) {
+    // Instances for different detectors write to the same file, only create the plots of one at a time
+    static std::mutex plot_mutex;
+    std::lock_guard<std::mutex> lock(plot_mutex);
+
     LOG(TRACE) << "Writing output plots";
 
     // Convert to pixel units if necessary
@@ -512,42 +511,46 @@ void GenericPropagationModule::init() {
             LOG(WARNING) << "A magnetic field is switched on, but is set to be ignored for this module.";
         } else {
             LOG(DEBUG) << "This detector sees a magnetic field.";
-            magnetic_field_ = detector_->getMagneticField();
         }
     }
 
     if(output_plots_) {
-        step_length_histo_ = new TH1D("step_length_histo",
-                                      "Step length;length [#mum];integration steps",
-                                      100,
-                                      0,
-                                      static_cast<double>(Units::convert(0.25 * model_->getSensorSize().z(), "um")));
-
-        drift_time_histo_ = new TH1D("drift_time_histo",
-                                     "Drift time;Drift time [ns];charge carriers",
-                                     static_cast<int>(Units::convert(integration_time_, "ns") * 5),
-                                     0,
-                                     static_cast<double>(Units::convert(integration_time_, "ns")));
+        step_length_histo_ =
+            CreateHistogram<TH1D>("step_length_histo",
+                                  "Step length;length [#mum];integration steps",
+                                  100,
+                                  0,
+                                  static_cast<double>(Units::convert(0.25 * model_->getSensorSize().z(), "um")));
+
+        drift_time_histo_ = CreateHistogram<TH1D>("drift_time_histo",
+                                                  "Drift time;Drift time [ns];charge carriers",
+                                                  static_cast<int>(Units::convert(integration_time_, "ns") * 5),
+                                                  0,
+                                                  static_cast<double>(Units::convert(integration_time_, "ns")));
 
         uncertainty_histo_ =
-            new TH1D("uncertainty_histo",
-                     "Position uncertainty;uncertainty [nm];integration steps",
-                     100,
-                     0,
-                     static_cast<double>(4 * Units::convert(config_.get<double>("spatial_precision"), "nm")));
-
-        group_size_histo_ = new TH1D("group_size_histo",
-                                     "Charge carrier group size;group size;number of groups trasnported",
-                                     config_.get<int>("charge_per_step") - 1,
-                                     1,
-                                     static_cast<double>(config_.get<unsigned int>("charge_per_step")));
+            CreateHistogram<TH1D>("uncertainty_histo",
+                                  "Position uncertainty;uncertainty [nm];integration steps",
+                                  100,
+                                  0,
+                                  static_cast<double>(4 * Units::convert(config_.get<double>("spatial_precision"), "nm")));
+
+        group_size_histo_ = CreateHistogram<TH1D>("group_size_histo",
+                                                  "Charge carrier group size;group size;number of groups trasnported",
+                                                  config_.get<int>("charge_per_step") - 1,
+                                                  1,
+                                                  static_cast<double>(config_.get<unsigned int>("charge_per_step")));
     }
 }
 
 void GenericPropagationModule::run(unsigned int event_num) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
 
     // Create vector of propagated charges to output
-    std::vector<PropagatedCharge> propagated_charges;
+    auto propagated_charges = messenger_->createMessageData<PropagatedCharge>();
 
     // Loop over all deposits for propagation
     LOG(TRACE) << "Propagating charges in sensor";
@@ -631,7 +634,8 @@ void GenericPropagationModule::run(unsigned int event_num) {
     total_time_ += total_time;
 
     // Create a new message with propagated charges
-    auto propagated_charge_message = std::make_shared<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
+    auto propagated_charge_message =
+        messenger_->createMessage<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
 
     // Dispatch the message with propagated charges
     messenger_->dispatchMessage(this, propagated_charge_message);
@@ -648,19 +652,7 @@ std::pair<ROOT::Math::XYZPoint, double> GenericPropagationModule::propagate(cons
     Eigen::Vector3d position(pos.x(), pos.y(), pos.z());
 
     // Define a lambda function to compute the carrier mobility
-    // NOTE This function is typically the most frequently executed part of the framework and therefore the bottleneck
-    auto carrier_mobility = [&](double efield_mag) {
-        // Compute carrier mobility from constants and electric field magnitude
-        double numerator, denominator;
-        if(type == CarrierType::ELECTRON) {
-            numerator = electron_Vm_ / electron_Ec_;
-            denominator = std::pow(1. + std::pow(efield_mag / electron_Ec_, electron_Beta_), 1.0 / electron_Beta_);
-        } else {
-            numerator = hole_Vm_ / hole_Ec_;
-            denominator = std::pow(1. + std::pow(efield_mag / hole_Ec_, hole_Beta_), 1.0 / hole_Beta_);
-        }
-        return numerator / denominator;
-    };
+    auto carrier_mobility = [&](double efield_mag) { return mobility_(type, efield_mag); };
 
     // Define a function to compute the diffusion
     auto carrier_diffusion = [&](double efield_mag, double timestep) -> Eigen::Vector3d {
@@ -691,7 +683,8 @@ std::pair<ROOT::Math::XYZPoint, double> GenericPropagationModule::propagate(cons
         Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
 
         Eigen::Vector3d velocity;
-        Eigen::Vector3d bfield(magnetic_field_.x(), magnetic_field_.y(), magnetic_field_.z());
+        auto raw_bfield = detector_->getMagneticField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
+        Eigen::Vector3d bfield(raw_bfield.x(), raw_bfield.y(), raw_bfield.z());
 
         auto mob = carrier_mobility(efield.norm());
         auto exb = efield.cross(bfield);
@@ -806,13 +799,26 @@ std::pair<ROOT::Math::XYZPoint, double> GenericPropagationModule::propagate(cons
 
 void GenericPropagationModule::finalize() {
     if(output_plots_) {
-        step_length_histo_->Write();
-        drift_time_histo_->Write();
-        uncertainty_histo_->Write();
-        group_size_histo_->Write();
+        step_length_histo_.Merge()->Write();
+        drift_time_histo_.Merge()->Write();
+        uncertainty_histo_.Merge()->Write();
+
+        // Every transported group of charge carriers is filled exactly once, independent of the thread propagating it
+        auto group_size_histo = group_size_histo_.Merge();
+        LOG(INFO) << "Merged output plots of " << group_size_histo->GetEntries()
+                  << " transported charge carrier groups from all threads";
+        group_size_histo->Write();
     }
 
     long double average_time = total_time_ / std::max(1u, total_propagated_charges_);
     LOG(INFO) << "Propagated total of " << total_propagated_charges_ << " charges in " << total_steps_
               << " steps in average time of " << Units::display(average_time, "ns");
 }
+
+void GenericPropagationModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n';
+}
+
+void GenericPropagationModule::loadState(std::istream& stream) {
+    stream >> random_generator_;
+}
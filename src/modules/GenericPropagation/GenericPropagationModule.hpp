@@ -24,6 +24,9 @@
 #include "objects/DepositedCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
 
+#include "tools/ROOT.h"
+#include "tools/mobility.h"
+
 namespace allpix {
     /**
      * @ingroup Modules
@@ -60,6 +63,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         Messenger* messenger_;
         std::shared_ptr<const Detector> detector_;
@@ -87,13 +100,8 @@ namespace allpix {
             target_spatial_precision_{}, output_plots_step_{};
         bool output_plots_{}, output_linegraphs_{}, output_animations_{}, output_plots_lines_at_implants_{};
 
-        // Precalculated values for electron and hole mobility
-        double electron_Vm_;
-        double electron_Ec_;
-        double electron_Beta_;
-        double hole_Vm_;
-        double hole_Ec_;
-        double hole_Beta_;
+        // Precalculated parameterization of the electron and hole mobility
+        JacoboniCanaliMobility mobility_;
 
         // Precalculated value for Boltzmann constant:
         double boltzmann_kT_;
@@ -104,7 +112,6 @@ namespace allpix {
 
         // Magnetic field
         bool has_magnetic_field_;
-        ROOT::Math::XYZVector magnetic_field_;
 
         // Deposits for the bound detector in this event
         std::shared_ptr<DepositedChargeMessage> deposits_message_;
@@ -116,10 +123,10 @@ namespace allpix {
 
         // List of points to plot to plot for output plots
         std::vector<std::pair<PropagatedCharge, std::vector<ROOT::Math::XYZPoint>>> output_plot_points_;
-        TH1D* step_length_histo_;
-        TH1D* drift_time_histo_;
-        TH1D* uncertainty_histo_;
-        TH1D* group_size_histo_;
+        Histogram<TH1D> step_length_histo_;
+        Histogram<TH1D> drift_time_histo_;
+        Histogram<TH1D> uncertainty_histo_;
+        Histogram<TH1D> group_size_histo_;
     };
 
 } // namespace allpix
@@ -10,6 +10,7 @@
 
 #include "GeometryConstructionG4.hpp"
 
+#include <fstream>
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,6 +33,7 @@
 
 #include "core/geometry/HybridPixelDetectorModel.hpp"
 #include "core/module/exceptions.h"
+#include "core/utils/file.h"
 #include "core/utils/log.h"
 #include "tools/ROOT.h"
 #include "tools/geant4.h"
@@ -125,8 +127,25 @@ G4VPhysicalVolume* GeometryConstructionG4::Construct() {
     const auto& detBuilder = new DetectorConstructionG4(geo_manager_);
     detBuilder->build(materials_, world_log_);
 
-    // Check for overlaps:
-    check_overlaps();
+    // Check for overlaps, unless the same geometry has already been checked successfully before
+    if(config_.has("cache_directory")) {
+        auto cache_directory = config_.getPath("cache_directory");
+        auto cache_file = cache_directory + "/geometry_" + geo_manager_->getConfigurationHash() + ".checked";
+        if(path_is_file(cache_file)) {
+            LOG(INFO) << "Skipping overlap check, geometry has been checked before according to cache file " << cache_file;
+        } else if(check_overlaps()) {
+            // Only geometries without overlaps are cached, such that overlaps are always reported
+            try {
+                create_directories(cache_directory);
+                std::ofstream(cache_file) << "No overlapping volumes detected" << std::endl;
+                LOG(DEBUG) << "Stored result of overlap check in cache file " << cache_file;
+            } catch(std::invalid_argument& e) {
+                LOG(WARNING) << "Cannot create cache directory " << cache_directory << ": " << e.what();
+            }
+        }
+    } else {
+        check_overlaps();
+    }
 
     return world_phys_.get();
 }
@@ -219,7 +238,7 @@ void GeometryConstructionG4::init_materials() {
     materials_["vacuum"] = new G4Material("Vacuum", 1, 1.008 * CLHEP::g / CLHEP::mole, CLHEP::universe_mean_density);
 }
 
-void GeometryConstructionG4::check_overlaps() {
+bool GeometryConstructionG4::check_overlaps() {
     G4PhysicalVolumeStore* phys_volume_store = G4PhysicalVolumeStore::GetInstance();
     LOG(TRACE) << "Checking overlaps";
     bool overlapFlag = false;
@@ -235,4 +254,5 @@ void GeometryConstructionG4::check_overlaps() {
     } else {
         LOG(INFO) << "No overlapping volumes detected.";
     }
+    return !overlapFlag;
 }
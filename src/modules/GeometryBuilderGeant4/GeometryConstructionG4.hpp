@@ -50,8 +50,9 @@ namespace allpix {
 
         /**
          * @brief Check all placed volumes for overlaps
+         * @return True if no overlapping volumes have been found, false otherwise
          */
-        void check_overlaps();
+        bool check_overlaps();
 
         // List of all materials
         std::map<std::string, G4Material*> materials_;
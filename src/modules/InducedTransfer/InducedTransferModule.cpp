@@ -9,8 +9,14 @@
 
 #include "InducedTransferModule.hpp"
 
+#include <algorithm>
+#include <map>
+#include <numeric>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "core/utils/log.h"
 #include "objects/PixelCharge.hpp"
@@ -50,8 +56,20 @@ void InducedTransferModule::run(unsigned int) {
     LOG(TRACE) << "Calculating induced charge on pixels";
     bool found_electrons = false, found_holes = false;
 
-    std::map<Pixel::Index, std::vector<std::pair<double, const PropagatedCharge*>>> pixel_map;
-    for(auto& propagated_charge : propagated_message_->getData()) {
+    const auto& propagated_charges = propagated_message_->getData();
+    auto pixel_size = model_->getPixelSize();
+
+    // Accumulate the induced charge in dense vectors, assigning a slot to every pixel when it is first touched
+    std::unordered_map<unsigned long long, size_t> pixel_slots;
+    std::vector<Pixel::Index> slot_pixels;
+    std::vector<double> induced_charges;
+    std::vector<std::vector<const PropagatedCharge*>> induced_propagated;
+
+    // Weighting potentials at the start point, shared between all charge carriers of a deposit with the same nearest pixel
+    std::map<std::tuple<const DepositedCharge*, int, int>, std::vector<double>> start_potentials;
+    std::vector<Pixel::Index> matrix_pixels;
+
+    for(const auto& propagated_charge : propagated_charges) {
 
         // Make sure both electrons and holes are present in the input data
         if(propagated_charge.getType() == CarrierType::ELECTRON) {
@@ -67,14 +85,15 @@ void InducedTransferModule::run(unsigned int) {
         auto position_start = deposited_charge->getLocalPosition();
 
         // Find the nearest pixel
-        auto xpixel = static_cast<int>(std::round(position_end.x() / model_->getPixelSize().x()));
-        auto ypixel = static_cast<int>(std::round(position_end.y() / model_->getPixelSize().y()));
+        auto xpixel = static_cast<int>(std::round(position_end.x() / pixel_size.x()));
+        auto ypixel = static_cast<int>(std::round(position_end.y() / pixel_size.y()));
         LOG(TRACE) << "Calculating induced charge from carriers below pixel "
                    << Pixel::Index(static_cast<unsigned int>(xpixel), static_cast<unsigned int>(ypixel)) << ", moved from "
                    << Units::display(position_start, {"um", "mm"}) << " to " << Units::display(position_end, {"um", "mm"})
                    << ", " << Units::display(propagated_charge.getEventTime() - deposited_charge->getEventTime(), "ns");
 
-        // Loop over NxN pixels:
+        // Collect the NxN pixels within the pixel grid
+        matrix_pixels.clear();
         for(int x = xpixel - matrix_.x() / 2; x <= xpixel + matrix_.x() / 2; x++) {
             for(int y = ypixel - matrix_.y() / 2; y <= ypixel + matrix_.y() / 2; y++) {
                 // Ignore if out of pixel grid
@@ -82,22 +101,44 @@ void InducedTransferModule::run(unsigned int) {
                     LOG(TRACE) << "Pixel (" << x << "," << y << ") skipped, outside the grid";
                     continue;
                 }
+                matrix_pixels.emplace_back(static_cast<unsigned int>(x), static_cast<unsigned int>(y));
+            }
+        }
 
-                Pixel::Index pixel_index(static_cast<unsigned int>(x), static_cast<unsigned int>(y));
-                auto ramo_end = detector_->getWeightingPotential(position_end, pixel_index);
-                auto ramo_start = detector_->getWeightingPotential(position_start, pixel_index);
-
-                // Induced charge on electrode is q_int = q * (phi(x1) - phi(x0))
-                auto induced = propagated_charge.getCharge() * (ramo_end - ramo_start) *
-                               (-static_cast<std::underlying_type<CarrierType>::type>(propagated_charge.getType()));
-                LOG(TRACE) << "Pixel " << pixel_index << " dPhi = " << (ramo_end - ramo_start) << ", induced "
-                           << propagated_charge.getType() << " q = " << Units::display(induced, "e");
+        // Query the weighting potential for all pixels at once, the start point only once per deposit and nearest pixel
+        auto ramo_end = detector_->getWeightingPotential(position_end, matrix_pixels);
+        auto key = std::make_tuple(deposited_charge, xpixel, ypixel);
+        auto ramo_start = start_potentials.find(key);
+        if(ramo_start == start_potentials.end()) {
+            ramo_start =
+                start_potentials.emplace(key, detector_->getWeightingPotential(position_start, matrix_pixels)).first;
+        }
 
-                // Add the pixel the list of hit pixels
-                pixel_map[pixel_index].emplace_back(induced, &propagated_charge);
+        auto sign = -static_cast<std::underlying_type<CarrierType>::type>(propagated_charge.getType());
+        for(size_t j = 0; j < matrix_pixels.size(); ++j) {
+            const auto& pixel_index = matrix_pixels[j];
+            auto delta_phi = ramo_end[j] - ramo_start->second[j];
+
+            // Induced charge on electrode is q_int = q * (phi(x1) - phi(x0))
+            auto induced = propagated_charge.getCharge() * delta_phi * sign;
+            LOG(TRACE) << "Pixel " << pixel_index << " dPhi = " << delta_phi << ", induced " << propagated_charge.getType()
+                       << " q = " << Units::display(induced, "e");
+
+            // Add the pixel the list of hit pixels
+            auto pixel_key = (static_cast<unsigned long long>(pixel_index.x()) << 32) | pixel_index.y();
+            auto slot = pixel_slots.emplace(pixel_key, slot_pixels.size());
+            if(slot.second) {
+                slot_pixels.push_back(pixel_index);
+                induced_charges.push_back(0.);
+                induced_propagated.emplace_back();
             }
+            induced_charges[slot.first->second] += induced;
+            induced_propagated[slot.first->second].push_back(&propagated_charge);
         }
     }
+    LOG(DEBUG) << "Induced charge on " << slot_pixels.size() << " pixels from " << propagated_charges.size()
+               << " propagated charges, evaluated start point potentials for " << start_potentials.size()
+               << " deposits and nearest pixels";
 
     // Send an error message if this even only contained one of the two carrier types
     if(!found_electrons || !found_holes) {
@@ -108,23 +149,22 @@ void InducedTransferModule::run(unsigned int) {
 
     // Create pixel charges
     LOG(TRACE) << "Combining charges at same pixel";
-    std::vector<PixelCharge> pixel_charges;
-    for(auto& pixel_index_charge : pixel_map) {
-        double charge = 0;
-        std::vector<const PropagatedCharge*> prop_charges;
-        for(auto& prop_pair : pixel_index_charge.second) {
-            charge += prop_pair.first;
-            prop_charges.push_back(prop_pair.second);
-        }
+    std::vector<size_t> slots(slot_pixels.size());
+    std::iota(slots.begin(), slots.end(), 0);
+    std::sort(slots.begin(), slots.end(), [&](size_t lhs, size_t rhs) { return slot_pixels[lhs] < slot_pixels[rhs]; });
 
+    auto pixel_charges = messenger_->createMessageData<PixelCharge>();
+    pixel_charges.reserve(slots.size());
+    for(auto slot : slots) {
         // Get pixel object from detector
-        auto pixel = detector_->getPixel(pixel_index_charge.first.x(), pixel_index_charge.first.y());
+        auto pixel = detector_->getPixel(slot_pixels[slot].x(), slot_pixels[slot].y());
 
-        pixel_charges.emplace_back(pixel, std::round(std::fabs(charge)), prop_charges);
+        auto charge = induced_charges[slot];
+        pixel_charges.emplace_back(pixel, std::round(std::fabs(charge)), induced_propagated[slot]);
         LOG(DEBUG) << "Set of " << charge << " charges combined at " << pixel.getIndex();
     }
 
     // Dispatch message of pixel charges
-    auto pixel_message = std::make_shared<PixelChargeMessage>(pixel_charges, detector_);
+    auto pixel_message = messenger_->createMessage<PixelChargeMessage>(std::move(pixel_charges), detector_);
     messenger_->dispatchMessage(this, pixel_message);
 }
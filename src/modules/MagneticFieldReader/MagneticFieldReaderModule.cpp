@@ -9,6 +9,8 @@
 
 #include "MagneticFieldReaderModule.hpp"
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <limits>
 #include <memory>
@@ -29,7 +31,10 @@
 using namespace allpix;
 
 MagneticFieldReaderModule::MagneticFieldReaderModule(Configuration& config, Messenger*, GeometryManager* geoManager)
-    : Module(config), geometryManager_(geoManager) {}
+    : Module(config), geometryManager_(geoManager) {
+    // No state changes during the event sequence, such that checkpoints do not need to store anything
+    enable_checkpointing();
+}
 
 void MagneticFieldReaderModule::init() {
     MagneticFieldType type = MagneticFieldType::NONE;
@@ -49,15 +54,110 @@ void MagneticFieldReaderModule::init() {
         geometryManager_->setMagneticFieldFunction(function, type);
         auto detectors = geometryManager_->getDetectors();
         for(auto& detector : detectors) {
-            // TODO the magnetic field is calculated once for the center position of the detector. This could be extended to
-            // a function enabling a gradient in the magnetic field inside the sensor
+            // The field is constant, so the value at the center position of the detector applies to the full sensor
             detector->setMagneticField(detector->getOrientation().Inverse() *
                                        geometryManager_->getMagneticField(detector->getPosition()));
             LOG(DEBUG) << "Magnetic field in detector " << detector->getName() << ": "
                        << Units::display(detector->getMagneticField(), {"T", "mT"});
         }
         LOG(INFO) << "Set constant magnetic field: " << Units::display(b_field, {"T", "mT"});
+    } else if(field_model == "mesh") {
+        LOG(TRACE) << "Adding magnetic field from field map";
+        type = MagneticFieldType::GRID;
+
+        auto field_data = read_field();
+        auto center = config_.get<ROOT::Math::XYZPoint>("field_center", ROOT::Math::XYZPoint());
+        auto dimensions = field_data.getDimensions();
+        auto size = field_data.getSize();
+        auto data = field_data.getData();
+
+        // The field values are given at the centers of the grid cells, the field is zero outside of the map
+        MagneticFieldFunction function = [data, dimensions, size, center](const ROOT::Math::XYZPoint& pos) {
+            auto dist = pos - center;
+            std::array<double, 3> coordinates{{dist.x(), dist.y(), dist.z()}};
+            std::array<double, 3> index{};
+            for(size_t i = 0; i < 3; ++i) {
+                auto position = coordinates[i] + size[i] / 2.0;
+                if(position < 0 || position > size[i]) {
+                    return ROOT::Math::XYZVector();
+                }
+                index[i] = position / size[i] * static_cast<double>(dimensions[i]) - 0.5;
+            }
+            return interpolate_vector_field(*data, dimensions, index);
+        };
+        geometryManager_->setMagneticFieldFunction(function, type);
+
+        // Cache the field in the local frame of every detector
+        auto sampling = config_.getArray<size_t>("sampling_points", {10, 10, 2});
+        if(sampling.size() != 3 || std::find(sampling.begin(), sampling.end(), 0) != sampling.end()) {
+            throw InvalidValueError(
+                config_, "sampling_points", "three numbers of sampling points larger than zero have to be provided");
+        }
+        auto detectors = geometryManager_->getDetectors();
+        for(auto& detector : detectors) {
+            sample_field(detector, {{sampling[0], sampling[1], sampling[2]}});
+            LOG(DEBUG) << "Magnetic field in detector " << detector->getName() << ": "
+                       << Units::display(detector->getMagneticField(), {"T", "mT"});
+        }
+        LOG(INFO) << "Set magnetic field from field map with " << dimensions[0] << "x" << dimensions[1] << "x"
+                  << dimensions[2] << " cells";
     } else {
-        throw InvalidValueError(config_, "model", "model can currently only be 'constant'");
+        throw InvalidValueError(config_, "model", "model can currently only be 'constant' or 'mesh'");
     }
 }
+
+/**
+ * The field data read from files are shared between module instantiations using the static FieldParser's getByFileName
+ * method.
+ */
+FieldParser<double> MagneticFieldReaderModule::field_parser_(FieldQuantity::VECTOR);
+FieldData<double> MagneticFieldReaderModule::read_field() {
+    try {
+        LOG(TRACE) << "Fetching magnetic field from mesh file";
+
+        // Get field from file
+        return field_parser_.getByFileName(config_.getPath("file_name", true), "T");
+    } catch(std::invalid_argument& e) {
+        throw InvalidValueError(config_, "file_name", e.what());
+    } catch(std::runtime_error& e) {
+        throw InvalidValueError(config_, "file_name", e.what());
+    } catch(std::bad_alloc& e) {
+        throw InvalidValueError(config_, "file_name", "file too large");
+    }
+}
+
+void MagneticFieldReaderModule::sample_field(const std::shared_ptr<Detector>& detector, std::array<size_t, 3> sampling) {
+    auto model = detector->getModel();
+    auto sensor_center = model->getSensorCenter();
+    auto sensor_size = model->getSensorSize();
+    std::array<double, 3> origin{{sensor_center.x() - sensor_size.x() / 2.0,
+                                  sensor_center.y() - sensor_size.y() / 2.0,
+                                  sensor_center.z() - sensor_size.z() / 2.0}};
+    std::array<double, 3> size{{sensor_size.x(), sensor_size.y(), sensor_size.z()}};
+
+    // Grid points span the sensor from edge to edge, a single point is placed in the sensor center
+    auto coordinate = [&](size_t axis, size_t index) {
+        if(sampling[axis] == 1) {
+            return origin[axis] + size[axis] / 2.0;
+        }
+        return origin[axis] + size[axis] * static_cast<double>(index) / static_cast<double>(sampling[axis] - 1);
+    };
+
+    auto rotation = detector->getOrientation().Inverse();
+    auto field = std::make_shared<std::vector<double>>();
+    field->reserve(sampling[0] * sampling[1] * sampling[2] * 3);
+    for(size_t x = 0; x < sampling[0]; ++x) {
+        for(size_t y = 0; y < sampling[1]; ++y) {
+            for(size_t z = 0; z < sampling[2]; ++z) {
+                ROOT::Math::XYZPoint local(coordinate(0, x), coordinate(1, y), coordinate(2, z));
+                auto b_field = rotation * geometryManager_->getMagneticField(detector->getGlobalPosition(local));
+                field->push_back(b_field.x());
+                field->push_back(b_field.y());
+                field->push_back(b_field.z());
+            }
+        }
+    }
+
+    auto b_center = rotation * geometryManager_->getMagneticField(detector->getGlobalPosition(sensor_center));
+    detector->setMagneticFieldGrid(b_center, field, sampling);
+}
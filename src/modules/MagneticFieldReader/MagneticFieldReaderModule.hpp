@@ -7,6 +7,7 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -18,13 +19,15 @@
 
 #include "core/module/Module.hpp"
 
+#include "tools/field_parser.h"
+
 namespace allpix {
     /**
      * @ingroup Modules
      * @brief Module to define magnetic fields
      *
-     * Read the model of the magnetic field from the config during initialization and apply a constant field throughout the
-     * whole volume
+     * Read the model of the magnetic field from the config during initialization and apply it to the whole volume. The field
+     * is either constant or read from a field map, which is interpolated and cached in the local frame of every detector.
      */
     class MagneticFieldReaderModule : public Module {
     public:
@@ -42,6 +45,20 @@ namespace allpix {
         void init() override;
 
     private:
+        /**
+         * @brief Read the field map from a file in init or apf format
+         * @return Field data read from file or cache
+         */
+        FieldData<double> read_field();
+        static FieldParser<double> field_parser_;
+
+        /**
+         * @brief Sample the magnetic field on a grid spanning the sensor and store it in the local frame of a detector
+         * @param detector Detector to sample the field for
+         * @param sampling Number of sampling points along the local x, y and z axis
+         */
+        void sample_field(const std::shared_ptr<Detector>& detector, std::array<size_t, 3> sampling);
+
         GeometryManager* geometryManager_;
     };
 } // namespace allpix
@@ -0,0 +1,283 @@
+/**
+ * @file
+ * @brief Implementation of module overlaying pre-generated charge deposits on the current event
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "PileupOverlayModule.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "core/utils/log.h"
+#include "core/utils/unit.h"
+
+#include "objects/exceptions.h"
+
+using namespace allpix;
+
+namespace {
+    ROOT::Math::XYZPoint to_point(const std::array<double, 3>& array) { return {array[0], array[1], array[2]}; }
+
+    /**
+     * @brief Merged objects of a single detector, with the references stored as indices until the message is created
+     */
+    struct MergedDetector {
+        MessageData<MCParticle> particles;
+        std::vector<int64_t> parents;
+        MessageData<DepositedCharge> deposits;
+        std::vector<int64_t> deposit_particles;
+    };
+
+    /**
+     * @brief Check if no module besides the receiving one holds the message anymore
+     *
+     * The messenger keeps all messages alive until the end of the event, the receiving module holds the second reference.
+     */
+    template <typename T> bool is_exclusive(const std::shared_ptr<Message<T>>& message) {
+        return message.use_count() <= 2;
+    }
+
+    /**
+     * @brief Append the objects of a received message to the merged objects
+     *
+     * The objects are moved if requested, otherwise they are copied. All references to the objects have to be resolved
+     * before, since they are invalidated by moving.
+     */
+    template <typename T> void take_data(const std::shared_ptr<Message<T>>& message, MessageData<T>& target, bool move) {
+        // The message itself is not const, only its interface for the receivers
+        auto& data = const_cast<MessageData<T>&>(message->getData()); // NOLINT
+        if(!move) {
+            target.insert(target.end(), data.begin(), data.end());
+        } else if(target.empty()) {
+            target = std::move(data);
+        } else {
+            target.insert(target.end(), std::make_move_iterator(data.begin()), std::make_move_iterator(data.end()));
+        }
+    }
+} // namespace
+
+PileupOverlayModule::PileupOverlayModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager)
+    : Module(config), messenger_(messenger), geo_manager_(geo_manager) {
+    // Seed the random generator with the seed received
+    random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
+
+    // Set default value for config variables
+    config_.setDefaultArray<double>("time_range", {0, 0});
+
+    // Bind to the deposits and particles of the current event, which are not required to allow overlaying pile-up only
+    messenger_->bindMulti(this, &PileupOverlayModule::deposit_messages_);
+    messenger_->bindMulti(this, &PileupOverlayModule::particle_messages_);
+}
+
+void PileupOverlayModule::init() {
+    auto mean_pileup = config_.get<double>("mean_pileup");
+    if(mean_pileup <= 0) {
+        throw InvalidValueError(config_, "mean_pileup", "mean number of pile-up events should be positive");
+    }
+    pileup_distribution_ = std::poisson_distribution<unsigned int>(mean_pileup);
+
+    auto time_range = config_.getArray<double>("time_range");
+    if(time_range.size() != 2 || time_range[0] > time_range[1]) {
+        throw InvalidValueError(config_, "time_range", "expected the minimum and maximum time offset");
+    }
+    time_distribution_ = std::uniform_real_distribution<double>(time_range[0], time_range[1]);
+
+    // Read the full replay file into memory to sample from it
+    auto file_name = config_.getPathWithExtension("file_name", "replay", true);
+    std::ifstream file(file_name, std::ios_base::in | std::ios_base::binary);
+    cereal::PortableBinaryInputArchive archive(file);
+
+    ReplayHeader header;
+    header.version = 0;
+    try {
+        archive(header);
+        if(header.version != ALLPIX_REPLAY_FORMAT_VERSION) {
+            throw InvalidValueError(config_,
+                                    "file_name",
+                                    "replay file has format version " + std::to_string(header.version) + " instead of " +
+                                        std::to_string(ALLPIX_REPLAY_FORMAT_VERSION));
+        }
+        while(file.peek() != EOF) {
+            pileup_events_.emplace_back();
+            archive(pileup_events_.back());
+        }
+    } catch(cereal::Exception& e) {
+        throw InvalidValueError(config_, "file_name", "file is not a valid replay file: " + std::string(e.what()));
+    }
+    if(pileup_events_.empty()) {
+        throw InvalidValueError(config_, "file_name", "replay file does not contain any events");
+    }
+    LOG(INFO) << "Read " << pileup_events_.size() << " events for overlay from " << file_name;
+
+    // Match the detectors of the file with the setup
+    for(auto& name : header.detectors) {
+        if(geo_manager_->hasDetector(name)) {
+            detectors_.push_back(geo_manager_->getDetector(name));
+        } else {
+            LOG(WARNING) << "Detector " << name << " of the replay file is not part of the setup, ignoring its deposits";
+            detectors_.push_back(nullptr);
+        }
+    }
+}
+
+void PileupOverlayModule::run(unsigned int) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+        pileup_distribution_.reset();
+        time_distribution_.reset();
+    }
+
+    std::map<std::shared_ptr<Detector>, MergedDetector> merged;
+
+    // Resolve the references of the current event to indices, they are restored after merging
+    std::map<const MCParticle*, int64_t> particle_index;
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = merged[geo_manager_->getDetector(message->getDetector()->getName())];
+        for(auto& particle : message->getData()) {
+            particle_index[&particle] = static_cast<int64_t>(entry.parents.size());
+            entry.parents.push_back(-1);
+        }
+    }
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = merged[geo_manager_->getDetector(message->getDetector()->getName())];
+        for(auto& particle : message->getData()) {
+            auto parent = particle_index.find(particle.getParent());
+            if(parent != particle_index.end()) {
+                entry.parents.at(static_cast<size_t>(particle_index[&particle])) = parent->second;
+            }
+        }
+    }
+    for(auto& message : deposit_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = merged[geo_manager_->getDetector(message->getDetector()->getName())];
+        for(auto& deposit : message->getData()) {
+            int64_t index = -1;
+            try {
+                auto particle = particle_index.find(deposit.getMCParticle());
+                if(particle != particle_index.end()) {
+                    index = particle->second;
+                }
+            } catch(MissingReferenceException&) {
+                // Deposits without particle keep an invalid index
+            }
+            entry.deposit_particles.push_back(index);
+        }
+    }
+
+    // Take over the particles and deposits of the current event in the same order. They are only moved out of the messages
+    // if no other module can read any of them anymore, since deposits refer to the particles of another message.
+    auto move = std::all_of(particle_messages_.begin(), particle_messages_.end(), is_exclusive<MCParticle>) &&
+                std::all_of(deposit_messages_.begin(), deposit_messages_.end(), is_exclusive<DepositedCharge>);
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() != nullptr) {
+            take_data(message, merged[geo_manager_->getDetector(message->getDetector()->getName())].particles, move);
+        }
+    }
+    for(auto& message : deposit_messages_) {
+        if(message->getDetector() != nullptr) {
+            take_data(message, merged[geo_manager_->getDetector(message->getDetector()->getName())].deposits, move);
+        }
+    }
+
+    // Add the deposits and particles of the sampled pile-up events, shifted by their time offset
+    auto pileup = pileup_distribution_(random_generator_);
+    LOG(DEBUG) << "Overlaying " << pileup << " pile-up events";
+    for(unsigned int i = 0; i < pileup; ++i) {
+        std::uniform_int_distribution<size_t> event_distribution(0, pileup_events_.size() - 1);
+        auto& event = pileup_events_.at(event_distribution(random_generator_));
+        auto time_offset = time_distribution_(random_generator_);
+        LOG(TRACE) << "Overlaying event " << event.number << " of the replay file with time offset "
+                   << Units::display(time_offset, {"ns", "us"});
+
+        for(auto& detector_entry : event.detectors) {
+            auto detector = detectors_.at(detector_entry.detector);
+            if(detector == nullptr) {
+                continue;
+            }
+            auto& entry = merged[detector];
+
+            auto offset = static_cast<int64_t>(entry.particles.size());
+            for(auto& particle : detector_entry.particles) {
+                entry.particles.emplace_back(to_point(particle.local_start),
+                                             to_point(particle.global_start),
+                                             to_point(particle.local_end),
+                                             to_point(particle.global_end),
+                                             particle.particle_id,
+                                             particle.time + time_offset);
+                entry.parents.push_back(particle.parent >= 0 ? offset + particle.parent : -1);
+            }
+            for(auto& deposit : detector_entry.deposits) {
+                entry.deposits.emplace_back(to_point(deposit.local_position),
+                                            to_point(deposit.global_position),
+                                            static_cast<CarrierType>(deposit.type),
+                                            deposit.charge,
+                                            deposit.time + time_offset);
+                entry.deposit_particles.push_back(deposit.particle >= 0 ? offset + deposit.particle : -1);
+            }
+            deposit_cnt_ += detector_entry.deposits.size();
+        }
+    }
+    pileup_cnt_ += pileup;
+    event_cnt_++;
+
+    // Dispatch the merged particles and deposits of every detector
+    for(auto& detector_merged : merged) {
+        auto& detector = detector_merged.first;
+        auto& entry = detector_merged.second;
+
+        // Restore the parents before the particles are moved into the message
+        for(size_t i = 0; i < entry.particles.size(); ++i) {
+            entry.particles.at(i).setParent(
+                entry.parents.at(i) >= 0 ? &entry.particles.at(static_cast<size_t>(entry.parents.at(i))) : nullptr);
+        }
+        LOG(DEBUG) << "Detector " << detector->getName() << " has " << entry.particles.size() << " MC particles";
+        auto mc_particle_message = messenger_->createMessage<MCParticleMessage>(std::move(entry.particles), detector);
+        messenger_->dispatchMessage(this, mc_particle_message);
+
+        if(entry.deposits.empty()) {
+            continue;
+        }
+        for(size_t i = 0; i < entry.deposits.size(); ++i) {
+            auto index = entry.deposit_particles.at(i);
+            entry.deposits.at(i).setMCParticle(
+                index >= 0 ? &mc_particle_message->getData().at(static_cast<size_t>(index)) : nullptr);
+        }
+        LOG(DEBUG) << "Detector " << detector->getName() << " has " << entry.deposits.size() << " deposits";
+        auto deposit_message = messenger_->createMessage<DepositedChargeMessage>(std::move(entry.deposits), detector);
+        messenger_->dispatchMessage(this, deposit_message);
+    }
+}
+
+void PileupOverlayModule::finalize() {
+    LOG(STATUS) << "Overlaid " << pileup_cnt_ << " pile-up events with " << deposit_cnt_ << " deposits on " << event_cnt_
+                << " events, " << (event_cnt_ > 0 ? static_cast<double>(pileup_cnt_) / static_cast<double>(event_cnt_) : 0)
+                << " per event on average";
+}
+
+void PileupOverlayModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n' << event_cnt_ << " " << pileup_cnt_ << " " << deposit_cnt_ << '\n';
+}
+
+void PileupOverlayModule::loadState(std::istream& stream) {
+    stream >> random_generator_ >> event_cnt_ >> pileup_cnt_ >> deposit_cnt_;
+    pileup_distribution_.reset();
+}
@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @brief Definition of module overlaying pre-generated charge deposits on the current event
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/GeometryManager.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/DepositedCharge.hpp"
+#include "objects/MCParticle.hpp"
+
+#include "tools/replay.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to overlay pile-up events from a replay file on the charge deposits of the current event
+     *
+     * Samples a number of events from a replay file following a Poisson distribution, shifts them by a random time offset
+     * and merges their deposits and particles with the deposits and particles received from previous modules. The merged
+     * objects are dispatched as a single message per detector.
+     */
+    class PileupOverlayModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this unique module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param geo_manager Pointer to the geometry manager, containing the detectors
+         */
+        PileupOverlayModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager);
+
+        /**
+         * @brief Read all events of the replay file into memory
+         */
+        void init() override;
+
+        /**
+         * @brief Overlay the sampled pile-up events on the current event and dispatch the merged messages
+         */
+        void run(unsigned int) override;
+
+        /**
+         * @brief Print statistics on the overlaid events
+         */
+        void finalize() override;
+
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
+    private:
+        std::mt19937_64 random_generator_;
+
+        Messenger* messenger_;
+        GeometryManager* geo_manager_;
+
+        // Deposits and particles of the current event
+        std::vector<std::shared_ptr<DepositedChargeMessage>> deposit_messages_;
+        std::vector<std::shared_ptr<MCParticleMessage>> particle_messages_;
+
+        // Events available for overlay and the detectors of the replay file, null if not part of the setup
+        std::vector<ReplayEvent> pileup_events_;
+        std::vector<std::shared_ptr<Detector>> detectors_;
+
+        // Distribution of the number of overlaid events and their time offsets
+        std::poisson_distribution<unsigned int> pileup_distribution_;
+        std::uniform_real_distribution<double> time_distribution_;
+
+        // Statistical information about the overlaid events
+        unsigned long event_cnt_{};
+        unsigned long pileup_cnt_{};
+        unsigned long deposit_cnt_{};
+    };
+} // namespace allpix
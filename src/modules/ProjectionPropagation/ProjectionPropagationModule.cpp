@@ -27,6 +27,8 @@ ProjectionPropagationModule::ProjectionPropagationModule(Configuration& config,
     model_ = detector_->getModel();
 
     random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
 
     // Require deposits message for single detector
     messenger_->bindSingle(this, &ProjectionPropagationModule::deposits_message_, MsgFlags::REQUIRED);
@@ -50,15 +52,9 @@ ProjectionPropagationModule::ProjectionPropagationModule(Configuration& config,
         propagate_type_ = CarrierType::ELECTRON;
     }
 
-    // Parameterization variables from https://doi.org/10.1016/0038-1101(77)90054-5 (section 5.2)
+    // Precalculate the parameters of the carrier mobility
     auto temperature = config_.get<double>("temperature");
-    electron_Vm_ = Units::get(1.53e9 * std::pow(temperature, -0.87), "cm/s");
-    electron_Ec_ = Units::get(1.01 * std::pow(temperature, 1.55), "V/cm");
-    electron_Beta_ = 2.57e-2 * std::pow(temperature, 0.66);
-
-    hole_Vm_ = Units::get(1.62e8 * std::pow(temperature, -0.52), "cm/s");
-    hole_Ec_ = Units::get(1.24 * std::pow(temperature, 1.68), "V/cm");
-    hole_Beta_ = 0.46 * std::pow(temperature, 0.17);
+    mobility_ = JacoboniCanaliMobility(temperature);
 
     boltzmann_kT_ = Units::get(8.6173e-5, "eV/K") * temperature;
 
@@ -120,9 +116,13 @@ void ProjectionPropagationModule::init() {
 }
 
 void ProjectionPropagationModule::run(unsigned int) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
 
     // Create vector of propagated charges to output
-    std::vector<PropagatedCharge> propagated_charges;
+    auto propagated_charges = messenger_->createMessageData<PropagatedCharge>();
 
     double charge_lost = 0;
     double total_charge = 0;
@@ -163,18 +163,7 @@ void ProjectionPropagationModule::run(unsigned int) {
             double efield_mag_top = std::sqrt(efield_top.Mag2());
 
             // Define a lambda function to compute the carrier mobility
-            auto carrier_mobility = [&](double efield_magn) {
-                // Compute carrier mobility from constants and electric field magnitude
-                double numerator, denominator;
-                if(type == CarrierType::ELECTRON) {
-                    numerator = electron_Vm_ / electron_Ec_;
-                    denominator = std::pow(1. + std::pow(efield_magn / electron_Ec_, electron_Beta_), 1.0 / electron_Beta_);
-                } else {
-                    numerator = hole_Vm_ / hole_Ec_;
-                    denominator = std::pow(1. + std::pow(efield_magn / hole_Ec_, hole_Beta_), 1.0 / hole_Beta_);
-                }
-                return numerator / denominator;
-            };
+            auto carrier_mobility = [&](double efield_magn) { return mobility_(type, efield_magn); };
 
             double diffusion_time = 0;
 
@@ -242,8 +231,8 @@ void ProjectionPropagationModule::run(unsigned int) {
 
             // Calculate the drift time
             auto calc_drift_time = [&]() {
-                double Ec = (type == CarrierType::ELECTRON ? electron_Ec_ : hole_Ec_);
-                double zero_mobility = (type == CarrierType::ELECTRON ? electron_Vm_ / electron_Ec_ : hole_Vm_ / hole_Ec_);
+                double Ec = mobility_.getCriticalField(type);
+                double zero_mobility = carrier_mobility(0.);
 
                 return ((log(efield_mag_top) - log(efield_mag)) / slope_efield_ + std::abs(top_z_ - position.z()) / Ec) /
                        zero_mobility;
@@ -317,7 +306,8 @@ void ProjectionPropagationModule::run(unsigned int) {
     LOG(DEBUG) << "Total count of propagated charge carriers: " << propagated_charges.size();
 
     // Create a new message with propagated charges
-    auto propagated_charge_message = std::make_shared<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
+    auto propagated_charge_message =
+        messenger_->createMessage<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
 
     // Dispatch the message with propagated charges
     messenger_->dispatchMessage(this, propagated_charge_message);
@@ -334,3 +324,11 @@ void ProjectionPropagationModule::finalize() {
         }
     }
 }
+
+void ProjectionPropagationModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n';
+}
+
+void ProjectionPropagationModule::loadState(std::istream& stream) {
+    stream >> random_generator_;
+}
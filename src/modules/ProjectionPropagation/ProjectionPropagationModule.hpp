@@ -21,6 +21,8 @@
 #include "objects/DepositedCharge.hpp"
 #include "objects/PropagatedCharge.hpp"
 
+#include "tools/mobility.h"
+
 namespace allpix {
     /**
      * @ingroup Modules
@@ -55,6 +57,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         Messenger* messenger_;
         std::shared_ptr<const Detector> detector_;
@@ -73,13 +85,8 @@ namespace allpix {
         // Side to propagate too
         double top_z_;
 
-        // Precalculated values for electron and hole mobility
-        double hole_Vm_;
-        double hole_Ec_;
-        double hole_Beta_;
-        double electron_Vm_;
-        double electron_Ec_;
-        double electron_Beta_;
+        // Precalculated parameterization of the electron and hole mobility
+        JacoboniCanaliMobility mobility_;
 
         // Calculated slope of the electric field
         double slope_efield_;
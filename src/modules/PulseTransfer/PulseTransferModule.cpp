@@ -145,7 +145,7 @@ void PulseTransferModule::run(unsigned int event_num) {
     }
 
     // Create vector of pixel pulses to return for this detector
-    std::vector<PixelCharge> pixel_charges;
+    auto pixel_charges = messenger_->createMessageData<PixelCharge>();
     Pulse total_pulse;
     for(auto& pixel_index_pulse : pixel_pulse_map) {
         auto index = pixel_index_pulse.first;
@@ -210,7 +210,7 @@ void PulseTransferModule::run(unsigned int event_num) {
     }
 
     // Create a new message with pixel pulses and dispatch:
-    auto pixel_charge_message = std::make_shared<PixelChargeMessage>(std::move(pixel_charges), detector_);
+    auto pixel_charge_message = messenger_->createMessage<PixelChargeMessage>(std::move(pixel_charges), detector_);
     messenger_->dispatchMessage(this, pixel_charge_message);
 
     // Fill pixel charge histogram
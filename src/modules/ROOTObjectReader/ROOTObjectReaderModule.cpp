@@ -50,7 +50,7 @@ ROOTObjectReaderModule::~ROOTObjectReaderModule() {
  */
 template <typename T> static void add_creator(ROOTObjectReaderModule::MessageCreatorMap& map) {
     map[typeid(T)] = [&](std::vector<Object*> objects, std::shared_ptr<Detector> detector) {
-        std::vector<T> data;
+        MessageData<T> data;
         data.reserve(objects.size());
 
         // Copy the objects to data vector
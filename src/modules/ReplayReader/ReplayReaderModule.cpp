@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @brief Implementation of module reading charge deposits and Monte-Carlo particles from a replay file
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "ReplayReaderModule.hpp"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "core/utils/log.h"
+
+#include "objects/DepositedCharge.hpp"
+#include "objects/MCParticle.hpp"
+
+using namespace allpix;
+
+namespace {
+    ROOT::Math::XYZPoint to_point(const std::array<double, 3>& array) { return {array[0], array[1], array[2]}; }
+
+    /**
+     * @brief Cache of replay files shared by all instances in the process, indexed by their canonical path
+     * @note The content is kept until the end of the process to allow simulations run after each other to reuse it
+     */
+    std::map<std::string, std::shared_ptr<const ReplayReaderModule::ReplayCache>> replay_cache;
+    std::mutex replay_cache_mutex;
+} // namespace
+
+ReplayReaderModule::ReplayReaderModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager)
+    : Module(config), messenger_(messenger), geo_manager_(geo_manager) {
+    // Set default value for config variables
+    config_.setDefault<bool>("cache", false);
+}
+
+ReplayHeader ReplayReaderModule::read_header(cereal::PortableBinaryInputArchive& archive) {
+    ReplayHeader header;
+    header.version = 0;
+    try {
+        archive(header);
+    } catch(cereal::Exception& e) {
+        throw InvalidValueError(config_, "file_name", "file is not a valid replay file: " + std::string(e.what()));
+    }
+
+    if(header.version != ALLPIX_REPLAY_FORMAT_VERSION) {
+        throw InvalidValueError(config_,
+                                "file_name",
+                                "replay file has format version " + std::to_string(header.version) + " instead of " +
+                                    std::to_string(ALLPIX_REPLAY_FORMAT_VERSION));
+    }
+    return header;
+}
+
+void ReplayReaderModule::init() {
+    auto file_name = config_.getPathWithExtension("file_name", "replay", true);
+
+    ReplayHeader header;
+    if(config_.get<bool>("cache")) {
+        std::lock_guard<std::mutex> lock(replay_cache_mutex);
+        auto& cache = replay_cache[file_name];
+        if(cache == nullptr) {
+            // Read the full file into memory
+            LOG(STATUS) << "Caching replay file " << file_name;
+            std::ifstream file(file_name, std::ios_base::in | std::ios_base::binary);
+            cereal::PortableBinaryInputArchive archive(file);
+
+            auto new_cache = std::make_shared<ReplayCache>();
+            new_cache->header = read_header(archive);
+            while(file.peek() != EOF) {
+                new_cache->events.emplace_back();
+                archive(new_cache->events.back());
+            }
+            cache = std::move(new_cache);
+        } else {
+            LOG(INFO) << "Using cached content of replay file " << file_name;
+        }
+        cache_ = cache;
+        header = cache_->header;
+        LOG(DEBUG) << "Replay file contains " << cache_->events.size() << " events";
+    } else {
+        // Read the events on demand
+        input_file_ = std::make_unique<std::ifstream>(file_name, std::ios_base::in | std::ios_base::binary);
+        archive_ = std::make_unique<cereal::PortableBinaryInputArchive>(*input_file_);
+        header = read_header(*archive_);
+    }
+
+    // Skip the events before the first event of the simulation, the file is read sequentially
+    auto skip_events = getConfigManager()->getGlobalConfiguration().get<unsigned int>("skip_events", 0u);
+    if(skip_events > 0) {
+        LOG(INFO) << "Skipping the first " << skip_events << " events of the replay file";
+        if(cache_ != nullptr) {
+            next_event_ = skip_events;
+        } else {
+            ReplayEvent skipped_event;
+            for(unsigned int i = 0; i < skip_events && input_file_->peek() != EOF; ++i) {
+                (*archive_)(skipped_event);
+            }
+        }
+    }
+
+    // Match the detectors of the file with the setup
+    for(auto& name : header.detectors) {
+        if(geo_manager_->hasDetector(name)) {
+            detectors_.push_back(geo_manager_->getDetector(name));
+        } else {
+            LOG(WARNING) << "Detector " << name << " of the replay file is not part of the setup, ignoring its deposits";
+            detectors_.push_back(nullptr);
+        }
+    }
+}
+
+void ReplayReaderModule::run(unsigned int) {
+    // Fetch the next event from the cache or the file
+    ReplayEvent file_event;
+    const ReplayEvent* event = nullptr;
+    if(cache_ != nullptr) {
+        if(next_event_ >= cache_->events.size()) {
+            throw EndOfRunException("Requesting end of run, replay file only contains data for " +
+                                    std::to_string(cache_->events.size()) + " events");
+        }
+        event = &cache_->events.at(next_event_++);
+    } else {
+        if(input_file_->peek() == EOF) {
+            throw EndOfRunException("Requesting end of run, replay file only contains data for " +
+                                    std::to_string(event_cnt_) + " events");
+        }
+        try {
+            (*archive_)(file_event);
+        } catch(cereal::Exception& e) {
+            throw EndOfRunException("Problem reading from replay file, error: " + std::string(e.what()));
+        }
+        event = &file_event;
+    }
+    LOG(DEBUG) << "Replaying event " << event->number << " of the replay file";
+
+    for(auto& entry : event->detectors) {
+        auto detector = detectors_.at(entry.detector);
+        if(detector == nullptr) {
+            continue;
+        }
+
+        // Create the particles and assign their parents
+        auto particles = messenger_->createMessageData<MCParticle>();
+        particles.reserve(entry.particles.size());
+        for(auto& particle : entry.particles) {
+            particles.emplace_back(to_point(particle.local_start),
+                                   to_point(particle.global_start),
+                                   to_point(particle.local_end),
+                                   to_point(particle.global_end),
+                                   particle.particle_id,
+                                   particle.time);
+        }
+        for(size_t i = 0; i < particles.size(); ++i) {
+            if(entry.particles.at(i).parent >= 0) {
+                particles.at(i).setParent(&particles.at(static_cast<size_t>(entry.particles.at(i).parent)));
+            }
+        }
+        particle_cnt_ += particles.size();
+
+        // Send the mc particle information
+        LOG(DEBUG) << "Detector " << detector->getName() << " has " << particles.size() << " MC particles";
+        auto mc_particle_message = messenger_->createMessage<MCParticleMessage>(std::move(particles), detector);
+        messenger_->dispatchMessage(this, mc_particle_message);
+
+        if(entry.deposits.empty()) {
+            continue;
+        }
+
+        // Create the deposits and assign their particles
+        auto deposits = messenger_->createMessageData<DepositedCharge>();
+        deposits.reserve(entry.deposits.size());
+        for(auto& deposit : entry.deposits) {
+            deposits.emplace_back(to_point(deposit.local_position),
+                                  to_point(deposit.global_position),
+                                  static_cast<CarrierType>(deposit.type),
+                                  deposit.charge,
+                                  deposit.time);
+            if(deposit.particle >= 0) {
+                deposits.back().setMCParticle(&mc_particle_message->getData().at(static_cast<size_t>(deposit.particle)));
+            }
+        }
+        deposit_cnt_ += deposits.size();
+
+        // Dispatch the deposits
+        LOG(DEBUG) << "Detector " << detector->getName() << " has " << deposits.size() << " deposits";
+        auto deposit_message = messenger_->createMessage<DepositedChargeMessage>(std::move(deposits), detector);
+        messenger_->dispatchMessage(this, deposit_message);
+    }
+    event_cnt_++;
+}
+
+void ReplayReaderModule::finalize() {
+    LOG(STATUS) << "Replayed " << deposit_cnt_ << " deposits and " << particle_cnt_ << " particles in " << event_cnt_
+                << " events";
+}
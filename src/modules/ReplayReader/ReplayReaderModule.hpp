@@ -0,0 +1,92 @@
+/**
+ * @file
+ * @brief Definition of module reading charge deposits and Monte-Carlo particles from a replay file
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/GeometryManager.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Module.hpp"
+
+#include "tools/replay.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to read charge deposits and Monte-Carlo particles from a replay file
+     *
+     * Reads the replay files written by the ReplayWriter module and dispatches the stored MCParticle and DepositedCharge
+     * objects for every event. The content of a file can be cached in memory, such that it is only read once per process
+     * also if several simulations are replaying the same file.
+     */
+    class ReplayReaderModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this unique module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param geo_manager Pointer to the geometry manager, containing the detectors
+         */
+        ReplayReaderModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager);
+
+        /**
+         * @brief Open the replay file, read its header and optionally cache all events
+         */
+        void init() override;
+
+        /**
+         * @brief Dispatch the particles and deposits of the next event in the replay file
+         * @throws EndOfRunException If all events of the replay file have been read
+         */
+        void run(unsigned int event_num) override;
+
+        /**
+         * @brief Print statistics
+         */
+        void finalize() override;
+
+        /**
+         * @brief Content of a replay file cached in memory
+         */
+        struct ReplayCache {
+            ReplayHeader header;
+            std::vector<ReplayEvent> events;
+        };
+
+    private:
+        /**
+         * @brief Read the header of the replay file and check its version
+         * @param archive Archive to read from
+         * @return Header of the replay file
+         */
+        ReplayHeader read_header(cereal::PortableBinaryInputArchive& archive);
+
+        Messenger* messenger_;
+        GeometryManager* geo_manager_;
+
+        // Input file and archive, only used if the file is not cached
+        std::unique_ptr<std::ifstream> input_file_;
+        std::unique_ptr<cereal::PortableBinaryInputArchive> archive_;
+
+        // Content of the file if cached and the index of the next event
+        std::shared_ptr<const ReplayCache> cache_;
+        size_t next_event_{};
+
+        // Detectors in the order of the header of the replay file, null if not part of the setup
+        std::vector<std::shared_ptr<Detector>> detectors_;
+
+        // Statistical information about the number of objects read
+        unsigned long event_cnt_{};
+        unsigned long deposit_cnt_{};
+        unsigned long particle_cnt_{};
+    };
+} // namespace allpix
@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief Implementation of module writing charge deposits and Monte-Carlo particles to a replay file
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "ReplayWriterModule.hpp"
+
+#include <string>
+#include <utility>
+
+#include "core/utils/file.h"
+#include "core/utils/log.h"
+
+#include "objects/exceptions.h"
+
+using namespace allpix;
+
+namespace {
+    std::array<double, 3> to_array(const ROOT::Math::XYZPoint& point) { return {{point.x(), point.y(), point.z()}}; }
+} // namespace
+
+ReplayWriterModule::ReplayWriterModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager)
+    : Module(config), geo_manager_(geo_manager) {
+    // Bind to all deposits and particles
+    messenger->bindMulti(this, &ReplayWriterModule::deposit_messages_);
+    messenger->bindMulti(this, &ReplayWriterModule::particle_messages_);
+}
+
+void ReplayWriterModule::init() {
+    // Create output file
+    output_file_name_ =
+        createOutputFile(allpix::add_file_extension(config_.get<std::string>("file_name", "deposits"), "replay"), true);
+    output_file_ = std::make_unique<std::ofstream>(output_file_name_, std::ios_base::out | std::ios_base::binary);
+    if(!output_file_->good()) {
+        throw InvalidValueError(config_, "file_name", "replay file cannot be opened for writing");
+    }
+    archive_ = std::make_unique<cereal::PortableBinaryOutputArchive>(*output_file_);
+
+    // Write the header with all detectors of the setup
+    ReplayHeader header;
+    for(auto& detector : geo_manager_->getDetectors()) {
+        detector_index_[detector->getName()] = static_cast<uint32_t>(header.detectors.size());
+        header.detectors.push_back(detector->getName());
+    }
+    (*archive_)(header);
+}
+
+void ReplayWriterModule::run(unsigned int event_num) {
+    ReplayEvent event;
+    event.number = event_num;
+
+    // Fetch the entry of a detector in the event, creating it if necessary
+    std::map<std::string, size_t> detector_entries;
+    auto get_detector = [&](const std::shared_ptr<const Detector>& detector) -> ReplayDetector& {
+        auto iter = detector_entries.find(detector->getName());
+        if(iter == detector_entries.end()) {
+            iter = detector_entries.emplace(detector->getName(), event.detectors.size()).first;
+            event.detectors.emplace_back();
+            event.detectors.back().detector = detector_index_.at(detector->getName());
+        }
+        return event.detectors.at(iter->second);
+    };
+
+    // Store all particles and keep track of their index to resolve the references
+    std::map<const MCParticle*, int64_t> particle_index;
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = get_detector(message->getDetector());
+        for(auto& particle : message->getData()) {
+            particle_index[&particle] = static_cast<int64_t>(entry.particles.size());
+
+            ReplayParticle replay_particle;
+            replay_particle.local_start = to_array(particle.getLocalStartPoint());
+            replay_particle.global_start = to_array(particle.getGlobalStartPoint());
+            replay_particle.local_end = to_array(particle.getLocalEndPoint());
+            replay_particle.global_end = to_array(particle.getGlobalEndPoint());
+            replay_particle.particle_id = particle.getParticleID();
+            replay_particle.time = particle.getTime();
+            entry.particles.push_back(replay_particle);
+        }
+    }
+
+    // Resolve the parents of the particles, which are always in the same detector
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = get_detector(message->getDetector());
+        for(auto& particle : message->getData()) {
+            auto parent = particle_index.find(particle.getParent());
+            if(parent != particle_index.end()) {
+                entry.particles.at(static_cast<size_t>(particle_index.at(&particle))).parent = parent->second;
+            }
+        }
+        particle_cnt_ += message->getData().size();
+    }
+
+    // Store all deposits with a reference to their particle
+    for(auto& message : deposit_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = get_detector(message->getDetector());
+        for(auto& deposit : message->getData()) {
+            ReplayDeposit replay_deposit;
+            replay_deposit.local_position = to_array(deposit.getLocalPosition());
+            replay_deposit.global_position = to_array(deposit.getGlobalPosition());
+            replay_deposit.type = static_cast<int8_t>(deposit.getType());
+            replay_deposit.charge = deposit.getCharge();
+            replay_deposit.time = deposit.getEventTime();
+
+            try {
+                auto particle = particle_index.find(deposit.getMCParticle());
+                if(particle != particle_index.end()) {
+                    replay_deposit.particle = particle->second;
+                }
+            } catch(MissingReferenceException&) {
+                // Deposits without particle keep an invalid index
+            }
+            entry.deposits.push_back(replay_deposit);
+        }
+        deposit_cnt_ += message->getData().size();
+    }
+
+    LOG(TRACE) << "Writing " << event.detectors.size() << " detectors to replay file";
+    (*archive_)(event);
+    event_cnt_++;
+}
+
+void ReplayWriterModule::finalize() {
+    // Close the archive before the file to flush all data
+    archive_.reset();
+    output_file_->close();
+
+    LOG(STATUS) << "Wrote " << deposit_cnt_ << " deposits and " << particle_cnt_ << " particles in " << event_cnt_
+                << " events to file:" << std::endl
+                << output_file_name_;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @brief Definition of module writing charge deposits and Monte-Carlo particles to a replay file
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/GeometryManager.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/DepositedCharge.hpp"
+#include "objects/MCParticle.hpp"
+
+#include "tools/replay.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to write charge deposits and Monte-Carlo particles to a compact replay file
+     *
+     * Listens to all DepositedCharge and MCParticle messages and stores their content in a portable binary file, which can
+     * be read back by the ReplayReader module to repeat the simulation of the detector response without the deposition.
+     */
+    class ReplayWriterModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this unique module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param geo_manager Pointer to the geometry manager, containing the detectors
+         */
+        ReplayWriterModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager);
+
+        /**
+         * @brief Open the replay file and write the header with the list of detectors
+         */
+        void init() override;
+
+        /**
+         * @brief Write the deposits and particles of the current event to the replay file
+         */
+        void run(unsigned int event_num) override;
+
+        /**
+         * @brief Close the replay file and print statistics
+         */
+        void finalize() override;
+
+    private:
+        GeometryManager* geo_manager_;
+
+        // Messages to write
+        std::vector<std::shared_ptr<DepositedChargeMessage>> deposit_messages_;
+        std::vector<std::shared_ptr<MCParticleMessage>> particle_messages_;
+
+        // Output file and archive
+        std::string output_file_name_;
+        std::unique_ptr<std::ofstream> output_file_;
+        std::unique_ptr<cereal::PortableBinaryOutputArchive> archive_;
+
+        // Index of every detector in the header of the replay file
+        std::map<std::string, uint32_t> detector_index_;
+
+        // Statistical information about the number of objects written
+        unsigned long event_cnt_{};
+        unsigned long deposit_cnt_{};
+        unsigned long particle_cnt_{};
+    };
+} // namespace allpix
@@ -32,6 +32,9 @@ SimpleTransferModule::SimpleTransferModule(Configuration& config, Messenger* mes
     // Enable parallelization of this module if multithreading is enabled
     enable_parallelization();
 
+    // No state changes during the event sequence, such that checkpoints do not need to store anything
+    enable_checkpointing();
+
     // Set default value for the maximum depth distance to transfer
     config_.setDefault("max_depth_distance", Units::get(5.0, "um"));
 
@@ -132,7 +135,7 @@ void SimpleTransferModule::run(unsigned int) {
 
     // Create pixel charges
     LOG(TRACE) << "Combining charges at same pixel";
-    std::vector<PixelCharge> pixel_charges;
+    auto pixel_charges = messenger_->createMessageData<PixelCharge>();
     for(auto& pixel_index_charge : pixel_map) {
         unsigned int charge = 0;
         for(auto& propagated_charge : pixel_index_charge.second) {
@@ -151,7 +154,7 @@ void SimpleTransferModule::run(unsigned int) {
     total_transferred_charges_ += transferred_charges_count;
 
     // Dispatch message of pixel charges
-    auto pixel_message = std::make_shared<PixelChargeMessage>(pixel_charges, detector_);
+    auto pixel_message = messenger_->createMessage<PixelChargeMessage>(std::move(pixel_charges), detector_);
     messenger_->dispatchMessage(this, pixel_message);
 }
 
@@ -0,0 +1,371 @@
+/**
+ * @file
+ * @brief Implementation of module streaming pixel hits and Monte-Carlo particles over a Unix domain socket or named pipe
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include "StreamWriterModule.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "core/module/exceptions.h"
+#include "core/utils/log.h"
+#include "core/utils/unit.h"
+
+#include "objects/exceptions.h"
+
+using namespace allpix;
+
+namespace {
+    std::array<double, 3> to_array(const ROOT::Math::XYZPoint& point) { return {{point.x(), point.y(), point.z()}}; }
+} // namespace
+
+StreamWriterModule::StreamWriterModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager)
+    : Module(config), geo_manager_(geo_manager) {
+    // Bind to all hits and particles, events without hits are streamed as well
+    messenger->bindMulti(this, &StreamWriterModule::pixel_messages_);
+    messenger->bindMulti(this, &StreamWriterModule::particle_messages_);
+
+    // Set default value for config variables
+    config_.setDefault<std::string>("type", "socket");
+    config_.setDefault<double>("timeout", Units::get(60, "s"));
+}
+
+StreamWriterModule::~StreamWriterModule() {
+    if(fd_ >= 0) {
+        close(fd_);
+    }
+    if(listen_fd_ >= 0) {
+        close(listen_fd_);
+        unlink(path_.c_str());
+    }
+}
+
+void StreamWriterModule::init() {
+    type_ = config_.get<std::string>("type");
+    std::transform(type_.begin(), type_.end(), type_.begin(), ::tolower);
+    path_ = config_.getPath("path");
+
+    if(type_ == "socket") {
+        open_socket();
+    } else if(type_ == "pipe") {
+        open_pipe();
+    } else {
+        throw InvalidValueError(config_, "type", "stream type should be 'socket' or 'pipe'");
+    }
+    LOG(STATUS) << "Consumer connected to " << type_ << " " << path_;
+
+    // Limit the amount of data buffered by the kernel to apply the backpressure of the consumer earlier
+    if(config_.has("buffer_size")) {
+        auto buffer_size = config_.get<int>("buffer_size");
+        if(type_ == "socket") {
+            if(setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size)) != 0) {
+                LOG(WARNING) << "Cannot set buffer size of socket: " << std::strerror(errno);
+            }
+        } else {
+#ifdef F_SETPIPE_SZ
+            if(fcntl(fd_, F_SETPIPE_SZ, buffer_size) < 0) {
+                LOG(WARNING) << "Cannot set buffer size of pipe: " << std::strerror(errno);
+            }
+#else
+            LOG(WARNING) << "Buffer size of pipes cannot be changed on this platform, ignoring parameter";
+#endif
+        }
+    }
+
+    // Send the header with all detectors of the setup
+    StreamHeader header;
+    for(auto& detector : geo_manager_->getDetectors()) {
+        detector_index_[detector->getName()] = static_cast<uint32_t>(header.detectors.size());
+        header.detectors.push_back(detector->getName());
+    }
+    if(!send_frame(header)) {
+        throw ModuleError("Consumer closed the " + type_ + " before receiving the header");
+    }
+}
+
+void StreamWriterModule::open_socket() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(path_.size() >= sizeof(address.sun_path)) {
+        throw InvalidValueError(config_, "path", "path is too long for a socket");
+    }
+    std::strncpy(address.sun_path, path_.c_str(), sizeof(address.sun_path) - 1);
+
+    // Remove the socket of a previous run
+    struct stat path_stat {};
+    if(stat(path_.c_str(), &path_stat) == 0) {
+        if(!S_ISSOCK(path_stat.st_mode)) {
+            throw InvalidValueError(config_, "path", "file exists and is not a socket");
+        }
+        unlink(path_.c_str());
+    }
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listen_fd_ < 0) {
+        throw ModuleError("Cannot create socket: " + std::string(std::strerror(errno)));
+    }
+    if(bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listen_fd_, 1) != 0) {
+        throw ModuleError("Cannot listen on socket " + path_ + ": " + std::string(std::strerror(errno)));
+    }
+
+    // Wait for the consumer to connect
+    LOG(STATUS) << "Waiting for consumer to connect to socket " << path_;
+    auto timeout = config_.get<double>("timeout");
+    auto timeout_ms = (timeout > 0 ? static_cast<int>(Units::convert(timeout, "ms")) : -1);
+    pollfd poll_fd{listen_fd_, POLLIN, 0};
+    int ready = 0;
+    do {
+        ready = poll(&poll_fd, 1, timeout_ms);
+    } while(ready < 0 && errno == EINTR);
+    if(ready <= 0) {
+        throw ModuleError("No consumer connected to socket " + path_ + " within " + Units::display(timeout, {"s", "ms"}));
+    }
+    fd_ = accept(listen_fd_, nullptr, nullptr);
+    if(fd_ < 0) {
+        throw ModuleError("Cannot accept connection on socket " + path_ + ": " + std::string(std::strerror(errno)));
+    }
+
+#ifdef SO_NOSIGPIPE
+    // Report a closed socket as error of the write instead of raising SIGPIPE, where sending cannot suppress it
+    int no_sigpipe = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+}
+
+void StreamWriterModule::open_pipe() {
+    // Create the named pipe if it does not exist yet
+    struct stat path_stat {};
+    if(stat(path_.c_str(), &path_stat) == 0) {
+        if(!S_ISFIFO(path_stat.st_mode)) {
+            throw InvalidValueError(config_, "path", "file exists and is not a named pipe");
+        }
+    } else if(mkfifo(path_.c_str(), 0600) != 0) {
+        throw ModuleError("Cannot create named pipe " + path_ + ": " + std::string(std::strerror(errno)));
+    }
+
+    // Opening for writing fails without blocking until the consumer opened the pipe for reading
+    LOG(STATUS) << "Waiting for consumer to open pipe " << path_;
+    auto timeout = config_.get<double>("timeout");
+    auto start = std::chrono::steady_clock::now();
+    while((fd_ = open(path_.c_str(), O_WRONLY | O_NONBLOCK)) < 0) {
+        if(errno != ENXIO && errno != EINTR) {
+            throw ModuleError("Cannot open named pipe " + path_ + ": " + std::string(std::strerror(errno)));
+        }
+        auto elapsed = static_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+        if(timeout > 0 && elapsed > Units::convert(timeout, "s")) {
+            throw ModuleError("No consumer opened pipe " + path_ + " within " + Units::display(timeout, {"s", "ms"}));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Switch to blocking writes to wait for the consumer if the pipe is full
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_NONBLOCK);
+
+#ifdef F_SETNOSIGPIPE
+    // Report a closed pipe as error of the write instead of raising SIGPIPE
+    fcntl(fd_, F_SETNOSIGPIPE, 1);
+#endif
+}
+
+template <typename T> bool StreamWriterModule::send_frame(const T& object) {
+    // Reserve space for the size of the payload before serializing the object
+    std::ostringstream buffer;
+    buffer.write("\0\0\0\0", 4);
+    {
+        cereal::PortableBinaryOutputArchive archive(buffer);
+        archive(object);
+    }
+    auto frame = buffer.str();
+
+    // Store the size of the payload in little-endian byte order
+    auto size = frame.size() - 4;
+    if(size > std::numeric_limits<uint32_t>::max()) {
+        throw ModuleError("Event is too large to be sent in a single frame");
+    }
+    for(size_t i = 0; i < 4; ++i) {
+        frame[i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    }
+    return write_data(frame.data(), frame.size());
+}
+
+/**
+ * A closed stream raises SIGPIPE, which terminates the process by default. The signal is suppressed for this write only,
+ * such that the signal handling of the process is not changed: sockets are written with MSG_NOSIGNAL, while for pipes the
+ * signal is blocked for the calling thread and a signal raised by the write is discarded before restoring the mask.
+ */
+ssize_t StreamWriterModule::write_nosignal(const char* data, size_t size) {
+#ifdef MSG_NOSIGNAL
+    if(type_ == "socket") {
+        return send(fd_, data, size, MSG_NOSIGNAL);
+    }
+#endif
+#ifdef F_SETNOSIGPIPE
+    return write(fd_, data, size);
+#else
+    sigset_t sigpipe_set, previous_set;
+    sigemptyset(&sigpipe_set);
+    sigaddset(&sigpipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe_set, &previous_set);
+
+    // Only discard the signal if it has been raised by this write
+    sigset_t pending_set;
+    sigpending(&pending_set);
+    auto was_pending = (sigismember(&pending_set, SIGPIPE) == 1);
+
+    auto written = write(fd_, data, size);
+    auto write_errno = errno;
+    if(written < 0 && write_errno == EPIPE && !was_pending) {
+        timespec no_wait{0, 0};
+        while(sigtimedwait(&sigpipe_set, nullptr, &no_wait) < 0 && errno == EINTR) {
+        }
+    }
+
+    pthread_sigmask(SIG_SETMASK, &previous_set, nullptr);
+    errno = write_errno;
+    return written;
+#endif
+}
+
+bool StreamWriterModule::write_data(const char* data, size_t size) {
+    while(size > 0) {
+        auto written = write_nosignal(data, size);
+        if(written < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            if(errno == EPIPE || errno == ECONNRESET) {
+                return false;
+            }
+            throw ModuleError("Cannot write to " + type_ + " " + path_ + ": " + std::string(std::strerror(errno)));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        byte_cnt_ += static_cast<unsigned long long>(written);
+    }
+    return true;
+}
+
+void StreamWriterModule::run(unsigned int event_num) {
+    StreamEvent event;
+    event.number = event_num;
+
+    // Fetch the entry of a detector in the event, creating it if necessary
+    std::map<std::string, size_t> detector_entries;
+    auto get_detector = [&](const std::shared_ptr<const Detector>& detector) -> StreamDetector& {
+        auto iter = detector_entries.find(detector->getName());
+        if(iter == detector_entries.end()) {
+            iter = detector_entries.emplace(detector->getName(), event.detectors.size()).first;
+            event.detectors.emplace_back();
+            event.detectors.back().detector = detector_index_.at(detector->getName());
+        }
+        return event.detectors.at(iter->second);
+    };
+
+    // Add all particles and keep track of their index to resolve the references
+    std::map<const MCParticle*, int64_t> particle_index;
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = get_detector(message->getDetector());
+        for(auto& particle : message->getData()) {
+            particle_index[&particle] = static_cast<int64_t>(entry.particles.size());
+
+            ReplayParticle stream_particle;
+            stream_particle.local_start = to_array(particle.getLocalStartPoint());
+            stream_particle.global_start = to_array(particle.getGlobalStartPoint());
+            stream_particle.local_end = to_array(particle.getLocalEndPoint());
+            stream_particle.global_end = to_array(particle.getGlobalEndPoint());
+            stream_particle.particle_id = particle.getParticleID();
+            stream_particle.time = particle.getTime();
+            entry.particles.push_back(stream_particle);
+        }
+        particle_cnt_ += message->getData().size();
+    }
+    for(auto& message : particle_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = get_detector(message->getDetector());
+        for(auto& particle : message->getData()) {
+            auto parent = particle_index.find(particle.getParent());
+            if(parent != particle_index.end()) {
+                entry.particles.at(static_cast<size_t>(particle_index.at(&particle))).parent = parent->second;
+            }
+        }
+    }
+
+    // Add all hits with the references to their particles
+    for(auto& message : pixel_messages_) {
+        if(message->getDetector() == nullptr) {
+            continue;
+        }
+        auto& entry = get_detector(message->getDetector());
+        for(auto& hit : message->getData()) {
+            StreamHit stream_hit;
+            stream_hit.index = {{hit.getIndex().x(), hit.getIndex().y()}};
+            stream_hit.local_center = to_array(hit.getPixel().getLocalCenter());
+            stream_hit.global_center = to_array(hit.getPixel().getGlobalCenter());
+            stream_hit.signal = hit.getSignal();
+            stream_hit.time = hit.getTime();
+
+            try {
+                for(auto& particle : hit.getMCParticles()) {
+                    auto index = particle_index.find(particle);
+                    if(index != particle_index.end()) {
+                        stream_hit.particles.push_back(index->second);
+                    }
+                }
+            } catch(MissingReferenceException&) {
+                // Hits without history are sent without particles
+            }
+            entry.hits.push_back(std::move(stream_hit));
+        }
+        hit_cnt_ += message->getData().size();
+    }
+
+    LOG(TRACE) << "Sending " << event.detectors.size() << " detectors to the consumer";
+    if(!send_frame(event)) {
+        throw EndOfRunException("Consumer closed the " + type_ + " after " + std::to_string(event_cnt_) + " events");
+    }
+    event_cnt_++;
+}
+
+void StreamWriterModule::finalize() {
+    // Mark the end of the stream with an empty frame, the consumer might have closed the stream already
+    if(fd_ >= 0) {
+        write_data("\0\0\0\0", 4);
+        close(fd_);
+        fd_ = -1;
+    }
+    if(listen_fd_ >= 0) {
+        close(listen_fd_);
+        listen_fd_ = -1;
+        unlink(path_.c_str());
+    }
+
+    LOG(STATUS) << "Streamed " << hit_cnt_ << " hits and " << particle_cnt_ << " particles in " << event_cnt_
+                << " events to the consumer, " << static_cast<double>(byte_cnt_) / 1e6 << " MB in total";
+}
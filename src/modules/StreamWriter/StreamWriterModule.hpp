@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @brief Definition of module streaming pixel hits and Monte-Carlo particles over a Unix domain socket or named pipe
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <sys/types.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/config/Configuration.hpp"
+#include "core/geometry/GeometryManager.hpp"
+#include "core/messenger/Messenger.hpp"
+#include "core/module/Module.hpp"
+
+#include "objects/MCParticle.hpp"
+#include "objects/PixelHit.hpp"
+
+#include "tools/stream.h"
+
+namespace allpix {
+    /**
+     * @ingroup Modules
+     * @brief Module to stream pixel hits and Monte-Carlo particles to a consumer process
+     *
+     * Sends the pixel hits and Monte-Carlo particles of every event in a compact binary format over a Unix domain socket or
+     * a named pipe, such that another process like a reconstruction can consume them while the simulation is running. The
+     * writes are blocking, such that the simulation is slowed down if the consumer cannot keep up.
+     */
+    class StreamWriterModule : public Module {
+    public:
+        /**
+         * @brief Constructor for this unique module
+         * @param config Configuration object for this module as retrieved from the steering file
+         * @param messenger Pointer to the messenger object to allow binding to messages on the bus
+         * @param geo_manager Pointer to the geometry manager, containing the detectors
+         */
+        StreamWriterModule(Configuration& config, Messenger* messenger, GeometryManager* geo_manager);
+
+        /**
+         * @brief Close the stream if still open
+         */
+        ~StreamWriterModule() override;
+
+        /**
+         * @brief Wait for the consumer to connect and send the header of the stream
+         */
+        void init() override;
+
+        /**
+         * @brief Send the hits and particles of the current event
+         * @throws EndOfRunException If the consumer closed the stream
+         */
+        void run(unsigned int event_num) override;
+
+        /**
+         * @brief Mark the end of the stream, close it and print statistics
+         */
+        void finalize() override;
+
+    private:
+        /**
+         * @brief Create a socket at the configured path and wait for a consumer to connect
+         */
+        void open_socket();
+
+        /**
+         * @brief Create a named pipe at the configured path if necessary and wait for a consumer to open it
+         */
+        void open_pipe();
+
+        /**
+         * @brief Serialize an object into a frame and write it to the stream
+         * @param object Object to send
+         * @return True if the frame has been sent, false if the consumer closed the stream
+         */
+        template <typename T> bool send_frame(const T& object);
+
+        /**
+         * @brief Write a buffer to the stream, blocking until all data has been written
+         * @param data Data to write
+         * @param size Number of bytes to write
+         * @return True if all data has been written, false if the consumer closed the stream
+         */
+        bool write_data(const char* data, size_t size);
+
+        /**
+         * @brief Write part of a buffer to the stream without raising SIGPIPE if the consumer closed the stream
+         * @param data Data to write
+         * @param size Maximum number of bytes to write
+         * @return Number of bytes written, or -1 on error with errno set
+         */
+        ssize_t write_nosignal(const char* data, size_t size);
+
+        GeometryManager* geo_manager_;
+
+        // Messages to stream
+        std::vector<std::shared_ptr<PixelHitMessage>> pixel_messages_;
+        std::vector<std::shared_ptr<MCParticleMessage>> particle_messages_;
+
+        // Stream to the consumer
+        std::string type_;
+        std::string path_;
+        int listen_fd_{-1};
+        int fd_{-1};
+
+        // Index of every detector in the header of the stream
+        std::map<std::string, uint32_t> detector_index_;
+
+        // Statistical information about the data sent
+        unsigned long event_cnt_{};
+        unsigned long hit_cnt_{};
+        unsigned long particle_cnt_{};
+        unsigned long long byte_cnt_{};
+    };
+} // namespace allpix
@@ -9,6 +9,8 @@
 
 #include "TextWriterModule.hpp"
 
+#include <unistd.h>
+
 #include <fstream>
 #include <string>
 #include <utility>
@@ -29,6 +31,9 @@ using namespace allpix;
 TextWriterModule::TextWriterModule(Configuration& config, Messenger* messenger, GeometryManager*) : Module(config) {
     // Bind to all messages
     messenger->registerListener(this, &TextWriterModule::receive);
+
+    // Continue the output file when resuming from a checkpoint
+    enable_checkpointing();
 }
 /**
  * @note Objects cannot be stored in smart pointers due to internal ROOT logic
@@ -44,9 +49,13 @@ void TextWriterModule::init() {
     // Create output file
     output_file_name_ =
         createOutputFile(allpix::add_file_extension(config_.get<std::string>("file_name", "data"), "txt"), true);
-    output_file_ = std::make_unique<std::ofstream>(output_file_name_);
+    // Continue the existing file if the simulation is resumed, it is restored to the checkpoint in loadState
+    auto resume = getConfigManager()->getGlobalConfiguration().get<bool>("resume", false);
+    output_file_ = std::make_unique<std::ofstream>(output_file_name_, resume ? std::ios_base::app : std::ios_base::out);
 
-    *output_file_ << "# Allpix Squared ASCII data - https://cern.ch/allpix-squared" << std::endl << std::endl;
+    if(!resume) {
+        *output_file_ << "# Allpix Squared ASCII data - https://cern.ch/allpix-squared" << std::endl << std::endl;
+    }
 
     // Read include and exclude list
     if(config_.has("include") && config_.has("exclude")) {
@@ -141,3 +150,30 @@ void TextWriterModule::finalize() {
     LOG(STATUS) << "Wrote " << write_cnt_ << " objects from " << msg_cnt_ << " messages to file:" << std::endl
                 << output_file_name_;
 }
+
+void TextWriterModule::saveState(std::ostream& stream) {
+    // Record the position up to which all events before the checkpoint have been written
+    output_file_->flush();
+    stream << output_file_->tellp() << ' ' << write_cnt_ << ' ' << msg_cnt_ << '\n';
+}
+
+/**
+ * @throws ModuleError If the output file cannot be restored to its state at the checkpoint
+ */
+void TextWriterModule::loadState(std::istream& stream) {
+    std::streamoff position = -1;
+    stream >> position >> write_cnt_ >> msg_cnt_;
+    if(stream.fail()) {
+        return;
+    }
+
+    // Discard the output of the events after the checkpoint, which are simulated again
+    output_file_.reset();
+    std::ifstream existing_file(output_file_name_, std::ios_base::ate);
+    if(!existing_file.good() || existing_file.tellg() < position ||
+       truncate(output_file_name_.c_str(), static_cast<off_t>(position)) != 0) {
+        throw ModuleError("Cannot restore output file " + output_file_name_ + " to its state at the checkpoint");
+    }
+    output_file_ = std::make_unique<std::ofstream>(output_file_name_, std::ios_base::app);
+    output_file_->seekp(0, std::ios_base::end);
+}
@@ -60,6 +60,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the position in the output file and the statistics in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the output file and the statistics from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         // Object names to include or exclude from writing
         std::set<std::string> include_;
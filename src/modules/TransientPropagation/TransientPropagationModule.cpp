@@ -42,6 +42,8 @@ TransientPropagationModule::TransientPropagationModule(Configuration& config,
 
     // Seed the random generator with the module seed
     random_generator_.seed(getRandomSeed());
+    // Store the state of the random generator in checkpoints
+    enable_checkpointing();
 
     // Set default value for config variables
     config_.setDefault<double>("timestep", Units::get(0.01, "ns"));
@@ -64,14 +66,8 @@ TransientPropagationModule::TransientPropagationModule(Configuration& config,
 
     output_plots_ = config_.get<bool>("output_plots");
 
-    // Parameterization variables from https://doi.org/10.1016/0038-1101(77)90054-5 (section 5.2)
-    electron_Vm_ = Units::get(1.53e9 * std::pow(temperature_, -0.87), "cm/s");
-    electron_Ec_ = Units::get(1.01 * std::pow(temperature_, 1.55), "V/cm");
-    electron_Beta_ = 2.57e-2 * std::pow(temperature_, 0.66);
-
-    hole_Vm_ = Units::get(1.62e8 * std::pow(temperature_, -0.52), "cm/s");
-    hole_Ec_ = Units::get(1.24 * std::pow(temperature_, 1.68), "V/cm");
-    hole_Beta_ = 0.46 * std::pow(temperature_, 0.17);
+    // Precalculate the parameters of the carrier mobility
+    mobility_ = JacoboniCanaliMobility(temperature_);
 
     boltzmann_kT_ = Units::get(8.6173e-5, "eV/K") * temperature_;
 
@@ -106,7 +102,6 @@ void TransientPropagationModule::init() {
             LOG(WARNING) << "A magnetic field is switched on, but is set to be ignored for this module.";
         } else {
             LOG(DEBUG) << "This detector sees a magnetic field.";
-            magnetic_field_ = detector_->getMagneticField();
         }
     }
 
@@ -147,9 +142,13 @@ void TransientPropagationModule::init() {
 }
 
 void TransientPropagationModule::run(unsigned int) {
+    // Reseed the random generator from the seed of this event if requested
+    if(hasEventSeeds()) {
+        random_generator_.seed(getRandomSeed());
+    }
 
     // Create vector of propagated charges to output
-    std::vector<PropagatedCharge> propagated_charges;
+    auto propagated_charges = messenger_->createMessageData<PropagatedCharge>();
 
     // Loop over all deposits for propagation
     LOG(TRACE) << "Propagating charges in sensor";
@@ -174,7 +173,7 @@ void TransientPropagationModule::run(unsigned int) {
 
             // Propagate a single charge deposit
             std::map<Pixel::Index, Pulse> px_map;
-            auto prop_pair = propagate(position, deposit.getType(), charge_per_step, px_map);
+            auto prop_pair = propagate(position, deposit.getType(), charge_per_step, deposit.getEventTime(), px_map);
 
             // Create a new propagated charge and add it to the list
             auto global_position = detector_->getGlobalPosition(prop_pair.first);
@@ -198,7 +197,8 @@ void TransientPropagationModule::run(unsigned int) {
     }
 
     // Create a new message with propagated charges
-    auto propagated_charge_message = std::make_shared<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
+    auto propagated_charge_message =
+        messenger_->createMessage<PropagatedChargeMessage>(std::move(propagated_charges), detector_);
 
     // Dispatch the message with propagated charges
     messenger_->dispatchMessage(this, propagated_charge_message);
@@ -212,25 +212,14 @@ void TransientPropagationModule::run(unsigned int) {
 std::pair<ROOT::Math::XYZPoint, double> TransientPropagationModule::propagate(const ROOT::Math::XYZPoint& pos,
                                                                               const CarrierType& type,
                                                                               const unsigned int charge,
+                                                                              const double initial_time,
                                                                               std::map<Pixel::Index, Pulse>& pixel_map) {
 
     // Create a runge kutta solver using the electric field as step function
     Eigen::Vector3d position(pos.x(), pos.y(), pos.z());
 
     // Define a lambda function to compute the carrier mobility
-    // NOTE This function is typically the most frequently executed part of the framework and therefore the bottleneck
-    auto carrier_mobility = [&](double efield_mag) {
-        // Compute carrier mobility from constants and electric field magnitude
-        double numerator, denominator;
-        if(type == CarrierType::ELECTRON) {
-            numerator = electron_Vm_ / electron_Ec_;
-            denominator = std::pow(1. + std::pow(efield_mag / electron_Ec_, electron_Beta_), 1.0 / electron_Beta_);
-        } else {
-            numerator = hole_Vm_ / hole_Ec_;
-            denominator = std::pow(1. + std::pow(efield_mag / hole_Ec_, hole_Beta_), 1.0 / hole_Beta_);
-        }
-        return numerator / denominator;
-    };
+    auto carrier_mobility = [&](double efield_mag) { return mobility_(type, efield_mag); };
 
     // Define a function to compute the diffusion
     auto carrier_diffusion = [&](double efield_mag, double timestep) -> Eigen::Vector3d {
@@ -248,20 +237,21 @@ std::pair<ROOT::Math::XYZPoint, double> TransientPropagationModule::propagate(co
 
     // Define lambda functions to compute the charge carrier velocity with or without magnetic field
     std::function<Eigen::Vector3d(double, const Eigen::Vector3d&)> carrier_velocity_noB =
-        [&](double, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
-        auto raw_field = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
+        [&](double cur_time, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
+        auto raw_field = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos), initial_time + cur_time);
         Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
 
         return static_cast<int>(type) * carrier_mobility(efield.norm()) * efield;
     };
 
     std::function<Eigen::Vector3d(double, const Eigen::Vector3d&)> carrier_velocity_withB =
-        [&](double, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
-        auto raw_field = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
+        [&](double cur_time, const Eigen::Vector3d& cur_pos) -> Eigen::Vector3d {
+        auto raw_field = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(cur_pos), initial_time + cur_time);
         Eigen::Vector3d efield(raw_field.x(), raw_field.y(), raw_field.z());
 
         Eigen::Vector3d velocity;
-        Eigen::Vector3d bfield(magnetic_field_.x(), magnetic_field_.y(), magnetic_field_.z());
+        auto raw_bfield = detector_->getMagneticField(static_cast<ROOT::Math::XYZPoint>(cur_pos));
+        Eigen::Vector3d bfield(raw_bfield.x(), raw_bfield.y(), raw_bfield.z());
 
         auto mob = carrier_mobility(efield.norm());
         auto exb = efield.cross(bfield);
@@ -293,8 +283,9 @@ std::pair<ROOT::Math::XYZPoint, double> TransientPropagationModule::propagate(co
         // Get the current result
         position = runge_kutta.getValue();
 
-        // Get electric field at current position and fall back to empty field if it does not exist
-        auto efield = detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(position));
+        // Get electric field at current position and time and fall back to empty field if it does not exist
+        auto efield =
+            detector_->getElectricField(static_cast<ROOT::Math::XYZPoint>(position), initial_time + runge_kutta.getTime());
 
         // Apply diffusion step
         auto diffusion = carrier_diffusion(std::sqrt(efield.Mag2()), timestep_);
@@ -396,3 +387,11 @@ void TransientPropagationModule::finalize() {
         induced_charge_h_histo_->Write();
     }
 }
+
+void TransientPropagationModule::saveState(std::ostream& stream) {
+    stream << random_generator_ << '\n';
+}
+
+void TransientPropagationModule::loadState(std::istream& stream) {
+    stream >> random_generator_;
+}
@@ -21,6 +21,7 @@
 #include "objects/DepositedCharge.hpp"
 #include "objects/Pulse.hpp"
 #include "tools/ROOT.h"
+#include "tools/mobility.h"
 
 namespace allpix {
     /**
@@ -57,6 +58,16 @@ namespace allpix {
          */
         void finalize() override;
 
+        /**
+         * @brief Store the state of the random generator in a checkpoint
+         */
+        void saveState(std::ostream& stream) override;
+
+        /**
+         * @brief Restore the state of the random generator from a checkpoint
+         */
+        void loadState(std::istream& stream) override;
+
     private:
         // General module members
         std::shared_ptr<const Detector> detector_;
@@ -69,6 +80,7 @@ namespace allpix {
          * @param pos       Position of the deposit in the sensor
          * @param type      Type of the carrier to propagate
          * @param charge    Total charge of the observed charge carrier set
+         * @param initial_time Time of the deposit relative to the start of the event, used for time-dependent fields
          * @param pixel_map Map of surrounding pixels and their induced pulses. Provided as reference to store simulation
          *                  result in
          * @return          Pair of the point where the deposit ended after propagation and the time the propagation took
@@ -76,6 +88,7 @@ namespace allpix {
         std::pair<ROOT::Math::XYZPoint, double> propagate(const ROOT::Math::XYZPoint& pos,
                                                           const CarrierType& type,
                                                           const unsigned int charge,
+                                                          const double initial_time,
                                                           std::map<Pixel::Index, Pulse>& pixel_map);
 
         // Random generator for this module
@@ -86,13 +99,8 @@ namespace allpix {
         bool output_plots_{};
         ROOT::Math::DisplacementVector2D<ROOT::Math::Cartesian2D<int>> matrix_;
 
-        // Precalculated values for electron and hole mobility
-        double electron_Vm_;
-        double electron_Ec_;
-        double electron_Beta_;
-        double hole_Vm_;
-        double hole_Ec_;
-        double hole_Beta_;
+        // Precalculated parameterization of the electron and hole mobility
+        JacoboniCanaliMobility mobility_;
 
         // Precalculated value for Boltzmann constant:
         double boltzmann_kT_;
@@ -103,7 +111,6 @@ namespace allpix {
 
         // Magnetic field
         bool has_magnetic_field_;
-        ROOT::Math::XYZVector magnetic_field_;
 
         // Output plots
         TH1D *potential_difference_, *induced_charge_histo_, *induced_charge_e_histo_, *induced_charge_h_histo_;
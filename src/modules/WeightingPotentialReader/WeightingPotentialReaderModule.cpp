@@ -31,12 +31,19 @@ WeightingPotentialReaderModule::WeightingPotentialReaderModule(Configuration& co
                                                                Messenger*,
                                                                std::shared_ptr<Detector> detector)
     : Module(config, detector), detector_(std::move(detector)) {
+    // No state changes during the event sequence, such that checkpoints do not need to store anything
+    enable_checkpointing();
 
     // NOTE Backwards-compatibility: interpret both "init" and "apf" as "mesh":
     auto model = config_.get<std::string>("model");
     if(model == "init" || model == "apf") {
         config_.set("model", "mesh");
     }
+
+    // Allow the field of all detectors to be loaded in parallel if no plots are created during initialization
+    if(!config_.get<bool>("output_plots", false)) {
+        enable_parallel_initialization();
+    }
 }
 
 void WeightingPotentialReaderModule::init() {
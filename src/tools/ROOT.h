@@ -10,6 +10,7 @@
 #ifndef ALLPIX_ROOT_H
 #define ALLPIX_ROOT_H
 
+#include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -20,6 +21,7 @@
 #include <Math/EulerAngles.h>
 #include <Math/PositionVector2D.h>
 #include <Math/PositionVector3D.h>
+#include <ROOT/TThreadedObject.hxx>
 #include <TString.h>
 
 #include "core/utils/text.h"
@@ -146,6 +148,40 @@ namespace allpix {
     inline std::ostream& operator<<(std::ostream& os, const ROOT::Math::PositionVector2D<T, U>& vec) {
         return os << "(" << vec.x() << "," << vec.y() << ")";
     }
+
+    /**
+     * @brief Histogram which can be filled from several threads
+     *
+     * Every thread fills its own copy of the histogram via the arrow operator, the copies are only merged when requested.
+     * The histogram is not attached to any ROOT directory, such that it can be created and filled independent of the current
+     * directory.
+     */
+    template <typename T> class Histogram : public std::unique_ptr<ROOT::TThreadedObject<T>> {
+    public:
+        using std::unique_ptr<ROOT::TThreadedObject<T>>::unique_ptr;
+
+        /**
+         * @brief Access the copy of the histogram of the current thread
+         * @return Histogram of the current thread
+         */
+        T* operator->() const { return this->get()->Get().get(); }
+
+        /**
+         * @brief Merge the copies of all threads
+         * @return Merged histogram
+         * @warning Should only be called when no thread is filling the histogram anymore
+         */
+        std::shared_ptr<T> Merge() const { return this->get()->Merge(); }
+    };
+
+    /**
+     * @brief Create a histogram which can be filled from several threads
+     * @param args Arguments passed to the constructor of the histogram
+     * @return Thread-safe histogram
+     */
+    template <typename T, typename... Args> Histogram<T> CreateHistogram(Args&&... args) {
+        return Histogram<T>(new ROOT::TThreadedObject<T>(std::forward<Args>(args)...));
+    }
 } // namespace allpix
 
 #endif /* ALLPIX_ROOT_H */
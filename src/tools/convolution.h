@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @brief Utility to convolve a sampled signal with a response function
+ * @copyright Copyright (c) 2017-2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_CONVOLUTION_H
+#define ALLPIX_CONVOLUTION_H
+
+#include <vector>
+
+namespace allpix {
+
+    /**
+     * @brief Convolve a signal with the response function of a system, for example the impulse response of an amplifier
+     * @param signal Signal to convolve, sampled with the same binning as the response function
+     * @param response Response function of the system
+     * @return Response of the system to the signal, with the same number of bins as the response function
+     */
+    inline std::vector<double> convolve(const std::vector<double>& signal, const std::vector<double>& response) {
+        auto ntimepoints = response.size();
+        auto input_length = signal.size();
+
+        std::vector<double> output(ntimepoints);
+        for(size_t k = 0; k < ntimepoints; ++k) {
+            double outsum{};
+            // convolution: multiply signal.at(k - i) * response.at(i), when (k - i) < input_length
+            // -> no point to start i at 0, start from jmin:
+            size_t jmin = (k >= input_length - 1) ? k - (input_length - 1) : 0;
+            for(size_t i = jmin; i <= k; ++i) {
+                if((k - i) < input_length) {
+                    outsum += signal.at(k - i) * response.at(i);
+                }
+            }
+            output.at(k) = outsum;
+        }
+        return output;
+    }
+} // namespace allpix
+
+#endif /* ALLPIX_CONVOLUTION_H */
@@ -12,8 +12,10 @@
 
 #include <algorithm>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <map>
+#include <mutex>
 
 #include "core/utils/file.h"
 #include "core/utils/log.h"
@@ -184,12 +186,67 @@ namespace allpix {
          */
         FieldData<T> getByFileName(const std::string& file_name, const std::string& units = std::string()) {
             // Search in cache (NOTE: the path reached here is always a canonical name)
+            std::unique_lock<std::mutex> lock(mutex_);
             auto iter = field_map_.find(file_name);
             if(iter != field_map_.end()) {
+                // Wait for the result if the file is currently parsed by another thread
+                auto field_data = iter->second;
+                lock.unlock();
                 LOG(INFO) << "Using cached field data";
-                return iter->second;
+                return field_data.get();
             }
 
+            // Register the file before parsing, so that concurrent requests for the same file wait for the result
+            std::promise<FieldData<T>> promise;
+            field_map_.emplace(file_name, promise.get_future().share());
+            lock.unlock();
+
+            try {
+                auto field_data = parse_file(file_name, units);
+                promise.set_value(field_data);
+                return field_data;
+            } catch(...) {
+                // Remove failed file from the cache
+                promise.set_exception(std::current_exception());
+                lock.lock();
+                field_map_.erase(file_name);
+                throw;
+            }
+        }
+
+        /**
+         * @brief Parse only the header of a file to retrieve the dimensions and size of the field
+         * @param file_name  File name (as canonical path) of the input file to be parsed
+         * @param units      Optional units to convert the field from, only used to check the units stated in the file
+         * @return           Field data object without field values, or the full field data if the file is cached
+         *
+         * The header is not stored in the cache, such that files can be validated without keeping their data in memory.
+         */
+        FieldData<T> getHeaderByFileName(const std::string& file_name, const std::string& units = std::string()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            auto iter = field_map_.find(file_name);
+            if(iter != field_map_.end()) {
+                auto field_data = iter->second;
+                lock.unlock();
+                return field_data.get();
+            }
+            lock.unlock();
+
+            if(guess_file_type(file_name) == FileType::APF) {
+                return parse_apf_header(file_name);
+            }
+            std::ifstream file(file_name);
+            return parse_init_header(file, file_name, units);
+        }
+
+    private:
+        /**
+         * @brief Parse a file deducing its format from the content
+         * @param file_name  File name (as canonical path) of the input file to be parsed
+         * @param units      Optional units to convert the field from after reading from file
+         * @return           Field data object read from file
+         */
+        FieldData<T> parse_file(const std::string& file_name, const std::string& units) {
             // Deduce the file format
             auto file_type = guess_file_type(file_name);
             LOG(DEBUG) << "Assuming file type \"" << (file_type == FileType::APF ? "APF" : "INIT") << "\"";
@@ -211,7 +268,6 @@ namespace allpix {
             }
         }
 
-    private:
         /**
          * @brief Function to guess the type of a field data file
          * @param path Path to the file to be tested
@@ -250,6 +306,34 @@ namespace allpix {
             return field_data;
         }
 
+        /**
+         * @brief Function to deserialize the header, dimensions and size of the field from an APF file without its data
+         * @param file_name  File name (as canonical path) of the input file to be parsed
+         */
+        FieldData<T> parse_apf_header(const std::string& file_name) {
+            std::ifstream file(file_name, std::ios::binary);
+            std::string header;
+            std::array<size_t, 3> dimensions{};
+            std::array<T, 3> size{};
+
+            // Read the members in the order of the serialization function, preceded by the version of the class
+            try {
+                cereal::PortableBinaryInputArchive archive(file);
+                std::uint32_t version = 0;
+                archive(version);
+                if(version != 1) {
+                    throw std::runtime_error("unknown format version " + std::to_string(version));
+                }
+                archive(header);
+                archive(dimensions);
+                archive(size);
+            } catch(cereal::Exception& e) {
+                throw std::runtime_error(e.what());
+            }
+
+            return FieldData<T>(header, dimensions, size, nullptr);
+        }
+
         /**
          * @brief Helper function to compare potential units defined in the INIT file against the ones provided:
          * @param file_units Unit string read from the file
@@ -274,15 +358,12 @@ namespace allpix {
         }
 
         /**
-         * @brief Function to read FieldData from INIT-formatted ASCII files. Values are interpreted in the units provided by
-         * the argument and converted to the framework-internal base units. The size of the field given in the file is always
-         * interpreted as micrometers.
+         * @brief Function to read the header of an INIT-formatted ASCII file, leaving the stream at the start of the data
+         * @param file       Stream of the input file
          * @param file_name  File name (as canonical path) of the input file to be parsed
-         * @param units      Units to convert the values of the field data from
+         * @param units      Units to compare the units stated in the file against
          */
-        FieldData<T> parse_init_file(const std::string& file_name, const std::string& units) {
-            // Load file
-            std::ifstream file(file_name);
+        FieldData<T> parse_init_header(std::ifstream& file, const std::string& file_name, const std::string& units) {
             std::string header;
             std::getline(file, header);
             LOG(TRACE) << "Header of file " << file_name << " is " << std::endl << header;
@@ -308,6 +389,29 @@ namespace allpix {
             if(file.fail()) {
                 throw std::runtime_error("invalid data or unexpected end of file");
             }
+
+            return FieldData<T>(header,
+                                std::array<size_t, 3>{{xsize, ysize, zsize}},
+                                std::array<T, 3>{{xpixsz, ypixsz, thickness}},
+                                nullptr);
+        }
+
+        /**
+         * @brief Function to read FieldData from INIT-formatted ASCII files. Values are interpreted in the units provided by
+         * the argument and converted to the framework-internal base units. The size of the field given in the file is always
+         * interpreted as micrometers.
+         * @param file_name  File name (as canonical path) of the input file to be parsed
+         * @param units      Units to convert the values of the field data from
+         */
+        FieldData<T> parse_init_file(const std::string& file_name, const std::string& units) {
+            // Load file
+            std::ifstream file(file_name);
+            auto header_data = parse_init_header(file, file_name, units);
+            auto dimensions = header_data.getDimensions();
+            auto xsize = dimensions[0];
+            auto ysize = dimensions[1];
+            auto zsize = dimensions[2];
+
             auto field = std::make_shared<std::vector<double>>();
             auto vertices = xsize * ysize * zsize;
             field->resize(vertices * N_);
@@ -344,16 +448,12 @@ namespace allpix {
             }
             LOG_PROGRESS(INFO, "read_init") << "Reading field data: finished.";
 
-            FieldData<T> field_data(
-                header, std::array<size_t, 3>{{xsize, ysize, zsize}}, std::array<T, 3>{{xpixsz, ypixsz, thickness}}, field);
-
-            // Store the parsed field data for further reference:
-            field_map_[file_name] = field_data;
-            return field_data;
+            return FieldData<T>(header_data.getHeader(), dimensions, header_data.getSize(), field);
         }
 
         size_t N_;
-        std::map<std::string, FieldData<T>> field_map_;
+        std::map<std::string, std::shared_future<FieldData<T>>> field_map_;
+        std::mutex mutex_;
     };
 
     /**
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @brief Utility to compute the mobility of charge carriers in silicon
+ * @copyright Copyright (c) 2017-2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_MOBILITY_H
+#define ALLPIX_MOBILITY_H
+
+#include <cmath>
+
+#include "core/utils/unit.h"
+#include "objects/SensorCharge.hpp"
+
+namespace allpix {
+
+    /**
+     * @brief Jacoboni-Canali parameterization of the charge carrier mobility as function of the electric field
+     *
+     * The parameters only depend on the temperature and are precalculated when constructing the parameterization. The
+     * parameterization variables are taken from https://doi.org/10.1016/0038-1101(77)90054-5 (section 5.2)
+     */
+    class JacoboniCanaliMobility {
+    public:
+        /**
+         * @brief Construct an empty parameterization, which needs to be assigned before use
+         */
+        JacoboniCanaliMobility() = default;
+
+        /**
+         * @brief Construct the parameterization for a given temperature
+         * @param temperature Temperature of the sensor
+         */
+        explicit JacoboniCanaliMobility(double temperature)
+            : electron_Vm_(Units::get(1.53e9 * std::pow(temperature, -0.87), "cm/s")),
+              electron_Ec_(Units::get(1.01 * std::pow(temperature, 1.55), "V/cm")),
+              electron_Beta_(2.57e-2 * std::pow(temperature, 0.66)),
+              hole_Vm_(Units::get(1.62e8 * std::pow(temperature, -0.52), "cm/s")),
+              hole_Ec_(Units::get(1.24 * std::pow(temperature, 1.68), "V/cm")),
+              hole_Beta_(0.46 * std::pow(temperature, 0.17)) {}
+
+        /**
+         * @brief Compute the mobility of a charge carrier
+         * @param type Type of the charge carrier
+         * @param efield_mag Magnitude of the electric field
+         * @return Mobility of the charge carrier
+         */
+        // NOTE This function is typically the most frequently executed part of the framework and therefore the bottleneck
+        double operator()(const CarrierType& type, double efield_mag) const {
+            // Compute carrier mobility from constants and electric field magnitude
+            double numerator, denominator;
+            if(type == CarrierType::ELECTRON) {
+                numerator = electron_Vm_ / electron_Ec_;
+                denominator = std::pow(1. + std::pow(efield_mag / electron_Ec_, electron_Beta_), 1.0 / electron_Beta_);
+            } else {
+                numerator = hole_Vm_ / hole_Ec_;
+                denominator = std::pow(1. + std::pow(efield_mag / hole_Ec_, hole_Beta_), 1.0 / hole_Beta_);
+            }
+            return numerator / denominator;
+        }
+
+        /**
+         * @brief Get the critical electric field of the parameterization, above which the drift velocity saturates
+         * @param type Type of the charge carrier
+         * @return Critical electric field
+         */
+        double getCriticalField(const CarrierType& type) const {
+            return (type == CarrierType::ELECTRON ? electron_Ec_ : hole_Ec_);
+        }
+
+    private:
+        double electron_Vm_{};
+        double electron_Ec_{};
+        double electron_Beta_{};
+        double hole_Vm_{};
+        double hole_Ec_{};
+        double hole_Beta_{};
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_MOBILITY_H */
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @brief Definition of the replay format storing charge deposits and Monte-Carlo particles
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef ALLPIX_REPLAY_H
+#define ALLPIX_REPLAY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cereal/archives/portable_binary.hpp>
+
+#include <cereal/types/array.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+// Version of the replay format, increased for every incompatible change
+#define ALLPIX_REPLAY_FORMAT_VERSION 1
+
+namespace allpix {
+
+    /**
+     * @brief Header of a replay file with the list of detectors referenced by the events
+     */
+    struct ReplayHeader {
+        uint32_t version{ALLPIX_REPLAY_FORMAT_VERSION};
+        std::vector<std::string> detectors;
+
+        template <class Archive> void serialize(Archive& archive) { archive(version, detectors); }
+    };
+
+    /**
+     * @brief Monte-Carlo particle stored in a replay file, the parent is given as index in the list of the same detector
+     */
+    struct ReplayParticle {
+        std::array<double, 3> local_start{};
+        std::array<double, 3> global_start{};
+        std::array<double, 3> local_end{};
+        std::array<double, 3> global_end{};
+        int32_t particle_id{};
+        double time{};
+        int64_t parent{-1};
+
+        template <class Archive> void serialize(Archive& archive) {
+            archive(local_start, global_start, local_end, global_end, particle_id, time, parent);
+        }
+    };
+
+    /**
+     * @brief Charge deposit stored in a replay file, the particle is given as index in the list of the same detector
+     */
+    struct ReplayDeposit {
+        std::array<double, 3> local_position{};
+        std::array<double, 3> global_position{};
+        int8_t type{};
+        uint32_t charge{};
+        double time{};
+        int64_t particle{-1};
+
+        template <class Archive> void serialize(Archive& archive) {
+            archive(local_position, global_position, type, charge, time, particle);
+        }
+    };
+
+    /**
+     * @brief Particles and deposits of a single detector in an event, the detector is given as index in the header
+     */
+    struct ReplayDetector {
+        uint32_t detector{};
+        std::vector<ReplayParticle> particles;
+        std::vector<ReplayDeposit> deposits;
+
+        template <class Archive> void serialize(Archive& archive) { archive(detector, particles, deposits); }
+    };
+
+    /**
+     * @brief Single event of a replay file, only containing the detectors with particles or deposits
+     */
+    struct ReplayEvent {
+        uint64_t number{};
+        std::vector<ReplayDetector> detectors;
+
+        template <class Archive> void serialize(Archive& archive) { archive(number, detectors); }
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_REPLAY_H */
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @brief Definition of the format to stream pixel hits and Monte-Carlo particles to other processes
+ * @copyright Copyright (c) 2020 CERN and the Allpix Squared authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ *
+ * The stream consists of frames, each starting with the size of its payload as 32-bit unsigned little-endian integer. The
+ * payload is serialized with the portable binary archive of cereal. The first frame contains the \ref allpix::StreamHeader,
+ * every following frame a single \ref allpix::StreamEvent. A frame with a payload of size zero marks the end of the stream.
+ */
+
+#ifndef ALLPIX_STREAM_H
+#define ALLPIX_STREAM_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <cereal/archives/portable_binary.hpp>
+
+#include <cereal/types/array.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "replay.h"
+
+// Version of the stream format, increased for every incompatible change
+#define ALLPIX_STREAM_FORMAT_VERSION 1
+
+namespace allpix {
+
+    /**
+     * @brief Header of a stream with the list of detectors referenced by the events
+     */
+    struct StreamHeader {
+        uint32_t version{ALLPIX_STREAM_FORMAT_VERSION};
+        std::vector<std::string> detectors;
+
+        template <class Archive> void serialize(Archive& archive) { archive(version, detectors); }
+    };
+
+    /**
+     * @brief Pixel hit sent in a stream, the particles are given as indices in the list of the same detector
+     */
+    struct StreamHit {
+        std::array<uint32_t, 2> index{};
+        std::array<double, 3> local_center{};
+        std::array<double, 3> global_center{};
+        double signal{};
+        double time{};
+        std::vector<int64_t> particles;
+
+        template <class Archive> void serialize(Archive& archive) {
+            archive(index, local_center, global_center, signal, time, particles);
+        }
+    };
+
+    /**
+     * @brief Particles and hits of a single detector in an event, the detector is given as index in the header
+     */
+    struct StreamDetector {
+        uint32_t detector{};
+        std::vector<ReplayParticle> particles;
+        std::vector<StreamHit> hits;
+
+        template <class Archive> void serialize(Archive& archive) { archive(detector, particles, hits); }
+    };
+
+    /**
+     * @brief Single event of a stream, only containing the detectors with particles or hits
+     */
+    struct StreamEvent {
+        uint64_t number{};
+        std::vector<StreamDetector> detectors;
+
+        template <class Archive> void serialize(Archive& archive) { archive(number, detectors); }
+    };
+} // namespace allpix
+
+#endif /* ALLPIX_STREAM_H */